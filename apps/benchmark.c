@@ -1,9 +1,17 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
+#include "la_blas.h"
+#include "la_elem.h"
 #include "la_matrix.h"
+#include "la_reduce.h"
 #include "la_solve.h"
+#include "la_prof.h"
+
+// Repetitions per timing; the fastest one is reported
+static const int BENCH_REPS = 3;
 
 // Makes a simple diagonally-dominant matrix 
 static void generate_system(Matrix *A, Matrix *b, size_t n) {
@@ -15,6 +23,135 @@ static void generate_system(Matrix *A, Matrix *b, size_t n) {
     }
 }
 
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+// One workload for the deterministic-mode comparison. run writes its
+// result into out (out_len doubles) so runs can be compared bit for bit.
+typedef struct {
+  const char *name;
+  la_status (*run)(const Matrix *A, const Matrix *B, double *out);
+  size_t out_len;
+} det_case;
+
+static la_status run_reduce(const Matrix *A, const Matrix *B, double *out) {
+    (void)B;
+    la_stats st = {0};
+    la_status s = la_reduce(&st, A, LA_STAT_SUM | LA_STAT_FRO | LA_STAT_NORM1 | LA_STAT_NORMINF);
+    out[0] = st.sum;
+    out[1] = st.fro;
+    out[2] = st.norm1;
+    out[3] = st.norminf;
+    return s;
+}
+
+static la_status run_axpy(const Matrix *A, const Matrix *B, double *out) {
+    (void)B;
+    Matrix Y = (Matrix){0};
+    la_status s = la_matrix_copy(&Y, A);
+    if (s == LA_OK) s = la_axpy(&Y, 0.5, A);
+    if (s == LA_OK) memcpy(out, Y.data, A->rows * A->cols * sizeof(double));
+    la_matrix_free(&Y);
+    return s;
+}
+
+// A X = B for all columns of B at once (LU + blocked triangular solves)
+static la_status run_lu_solve(const Matrix *A, const Matrix *B, double *out) {
+    la_lu f = {0};
+    Matrix X = (Matrix){0};
+    la_status s = la_lu_factor(&f, A, NULL);
+    if (s == LA_OK) s = la_lu_solve(&X, &f, B);
+    if (s == LA_OK) memcpy(out, X.data, B->rows * B->cols * sizeof(double));
+    la_matrix_free(&X);
+    la_lu_free(&f);
+    return s;
+}
+
+// Best-of-BENCH_REPS time of c in the current mode; the result lands in out
+static double time_case(const det_case *c, const Matrix *A, const Matrix *B, double *out) {
+    double best = 0.0;
+    for (int r = 0; r < BENCH_REPS; r++) {
+        const double t0 = now_seconds();
+        if (c->run(A, B, out) != LA_OK) return -1.0;
+        const double t = now_seconds() - t0;
+        if (r == 0 || t < best) best = t;
+    }
+    return best;
+}
+
+// Fast vs deterministic mode on the default threads, and whether the
+// deterministic results match bit for bit on one thread
+static int bench_deterministic(void) {
+    const size_t n = 1000;
+    Matrix A = (Matrix){0};
+    Matrix B = (Matrix){0};
+    if (la_matrix_init(&A, n, n) != LA_OK || la_matrix_init(&B, n, n) != LA_OK) {
+        la_matrix_free(&A);
+        return 1;
+    }
+
+    unsigned seed = 1u;
+    for (size_t k = 0; k < n * n; k++) {
+        seed = seed * 1103515245u + 12345u;
+        A.data[k] = (double)(seed >> 8) / 16777216.0 - 0.5;
+        B.data[k] = A.data[(k * 7) % (n * n)];
+    }
+    for (size_t i = 0; i < n; i++) {
+        LA_AT(&A, i, i) += (double)n;
+    }
+
+    const det_case cases[] = {
+        {"reduce (sum, fro, 1, inf)", run_reduce, 4},
+        {"axpy", run_axpy, n * n},
+        {"lu_factor + lu_solve", run_lu_solve, n * n},
+    };
+    double *fast = (double *)malloc(n * n * sizeof(double));
+    double *det = (double *)malloc(n * n * sizeof(double));
+    double *serial = (double *)malloc(n * n * sizeof(double));
+    if (!fast || !det || !serial) {
+        free(fast);
+        free(det);
+        free(serial);
+        la_matrix_free(&A);
+        la_matrix_free(&B);
+        return 1;
+    }
+
+    printf("\nDeterministic mode, %zux%zu:\n", n, n);
+    printf("%-28s %10s %10s %9s %10s\n", "kernel", "fast ms", "det ms", "overhead", "1-thread");
+    for (size_t k = 0; k < sizeof(cases) / sizeof(cases[0]); k++) {
+        const det_case *c = &cases[k];
+
+        la_set_deterministic(0);
+        la_blas_set_threads(0);
+        const double tf = time_case(c, &A, &B, fast);
+        la_set_deterministic(1);
+        const double td = time_case(c, &A, &B, det);
+        la_blas_set_threads(1);
+        const int ok = c->run(&A, &B, serial) == LA_OK &&
+                       memcmp(det, serial, c->out_len * sizeof(double)) == 0;
+        la_blas_set_threads(0);
+        la_set_deterministic(0);
+
+        if (tf < 0.0 || td < 0.0) {
+            printf("%-28s failed\n", c->name);
+            continue;
+        }
+        printf("%-28s %10.2f %10.2f %8.1f%% %10s\n", c->name, 1e3 * tf, 1e3 * td,
+               100.0 * (td - tf) / tf, ok ? "identical" : "DIFFERS");
+    }
+
+    free(fast);
+    free(det);
+    free(serial);
+    la_matrix_free(&A);
+    la_matrix_free(&B);
+    return 0;
+}
+
 int main(void) {
     const size_t N = 1000;   
 
@@ -46,9 +183,13 @@ int main(void) {
 
     printf("Solved %zux%zu system in %.3f seconds\n", N, N, seconds);
 
+    if (la_prof_enabled()) {
+        la_prof_dump_json(stdout);
+    }
+
     la_matrix_free(&A);
     la_matrix_free(&b);
     la_matrix_free(&x);
 
-    return 0;
+    return bench_deterministic();
 }
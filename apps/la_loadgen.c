@@ -0,0 +1,234 @@
+#define _POSIX_C_SOURCE 200809L  // getopt
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "la_matrix.h"
+#include "la_proto.h"
+
+// Load generator for la_server: each connection keeps `depth` requests in
+// flight, drawing A from a small pool of distinct matrices so the server's
+// factorization cache and batching are exercised. Prints client-side
+// latency percentiles and the server's own statistics.
+
+static struct {
+  const char *socket_path;
+  size_t conns;
+  size_t requests;  // per connection
+  size_t depth;
+  size_t size;
+  size_t pool;
+  uint32_t op;      // 0 = mix of mul/solve/det/inverse
+} g_cfg;
+
+typedef struct {
+  size_t index;
+  double *lat_us;   // one entry per completed request
+  size_t done;
+  size_t errors;
+} client;
+
+// Diagonally dominant n x n matrix, deterministic in seed
+static la_status make_matrix(Matrix *m, size_t rows, size_t cols, unsigned seed) {
+    la_status st = la_matrix_init(m, rows, cols);
+    if (st != LA_OK) return st;
+
+    unsigned x = seed * 2654435761u + 1u;
+    for (size_t i = 0; i < rows; i++) {
+        for (size_t j = 0; j < cols; j++) {
+            x = x * 1103515245u + 12345u;
+            LA_AT(m, i, j) = (double)((x >> 16) % 1000) / 1000.0 - 0.5;
+        }
+        if (i < cols) LA_AT(m, i, i) += (double)cols;
+    }
+    return LA_OK;
+}
+
+static uint32_t pick_op(size_t k) {
+    if (g_cfg.op != 0) return g_cfg.op;
+    static const uint32_t mix[] = {LA_OP_SOLVE, LA_OP_SOLVE, LA_OP_MUL, LA_OP_DET, LA_OP_INVERSE};
+    return mix[k % (sizeof(mix) / sizeof(mix[0]))];
+}
+
+static int send_request(int fd, uint64_t id, uint32_t op, const Matrix *A, const Matrix *b) {
+    la_req_header h = {LA_PROTO_MAGIC, op, id, 0, 0};
+    h.nmat = (op == LA_OP_MUL || op == LA_OP_SOLVE) ? 2 : 1;
+
+    if (!la_proto_write_full(fd, &h, sizeof(h))) return 0;
+    if (!la_proto_send_matrix(fd, A)) return 0;
+    if (op == LA_OP_MUL) return la_proto_send_matrix(fd, A);
+    if (op == LA_OP_SOLVE) return la_proto_send_matrix(fd, b);
+    return 1;
+}
+
+// Reads one response; returns its id via id_out, or 0 on I/O failure
+static int recv_response(int fd, uint64_t *id_out, int *status_out) {
+    la_resp_header h;
+    if (!la_proto_read_full(fd, &h, sizeof(h)) || h.magic != LA_PROTO_MAGIC) return 0;
+
+    for (uint32_t i = 0; i < h.nmat; i++) {
+        Matrix m = (Matrix){0};
+        if (!la_proto_recv_matrix(fd, &m)) return 0;
+        la_matrix_free(&m);
+    }
+    if (h.text_len > 0) {
+        char *text = (char *)malloc(h.text_len + 1);
+        if (!text || !la_proto_read_full(fd, text, h.text_len)) {
+            free(text);
+            return 0;
+        }
+        text[h.text_len] = '\0';
+        printf("%s", text);
+        free(text);
+    }
+    *id_out = h.id;
+    *status_out = h.status;
+    return 1;
+}
+
+static void *client_main(void *arg) {
+    client *cl = (client *)arg;
+    const size_t n = g_cfg.size;
+    const size_t total = g_cfg.requests;
+
+    Matrix *pool = (Matrix *)calloc(g_cfg.pool, sizeof(Matrix));
+    Matrix b = (Matrix){0};
+    double *t_send = (double *)malloc(total * sizeof(double));
+    int fd = la_proto_connect(g_cfg.socket_path);
+
+    int ok = pool && t_send && fd >= 0 && make_matrix(&b, n, 1, 7) == LA_OK;
+    for (size_t p = 0; ok && p < g_cfg.pool; p++) {
+        ok = (make_matrix(&pool[p], n, n, (unsigned)p + 1) == LA_OK);
+    }
+
+    size_t sent = 0;
+    while (ok && cl->done + cl->errors < total) {
+        // Keep `depth` requests in flight
+        while (ok && sent < total && sent - cl->done - cl->errors < g_cfg.depth) {
+            const Matrix *A = &pool[(cl->index + sent) % g_cfg.pool];
+            t_send[sent] = la_proto_now_us();
+            ok = send_request(fd, sent, pick_op(sent), A, &b);
+            sent++;
+        }
+
+        uint64_t id;
+        int status;
+        if (!ok || !recv_response(fd, &id, &status) || id >= sent) {
+            ok = 0;
+            break;
+        }
+        if (status == LA_OK) cl->lat_us[cl->done++] = la_proto_now_us() - t_send[id];
+        else cl->errors++;
+    }
+    if (!ok) cl->errors += total - cl->done - cl->errors;
+
+    if (fd >= 0) close(fd);
+    for (size_t p = 0; pool && p < g_cfg.pool; p++) la_matrix_free(&pool[p]);
+    free(pool);
+    free(t_send);
+    la_matrix_free(&b);
+    return NULL;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static uint32_t parse_op(const char *s) {
+    for (uint32_t op = 1; op < LA_OP_STATS; op++) {
+        if (strcmp(s, la_proto_op_name(op)) == 0) return op;
+    }
+    return 0;  // "mix" or anything else
+}
+
+static void usage(const char *prog) {
+    printf("Usage: %s [-s socket] [-c conns] [-n requests_per_conn] [-d depth]\n"
+           "          [-m size] [-p matrix_pool] [-o mul|solve|det|inverse|mix]\n", prog);
+}
+
+int main(int argc, char **argv) {
+    g_cfg.socket_path = LA_PROTO_DEFAULT_SOCKET;
+    g_cfg.conns = 4;
+    g_cfg.requests = 1000;
+    g_cfg.depth = 8;
+    g_cfg.size = 32;
+    g_cfg.pool = 4;
+    g_cfg.op = 0;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "s:c:n:d:m:p:o:h")) != -1) {
+        switch (opt) {
+        case 's': g_cfg.socket_path = optarg; break;
+        case 'c': g_cfg.conns = (size_t)strtoul(optarg, NULL, 10); break;
+        case 'n': g_cfg.requests = (size_t)strtoul(optarg, NULL, 10); break;
+        case 'd': g_cfg.depth = (size_t)strtoul(optarg, NULL, 10); break;
+        case 'm': g_cfg.size = (size_t)strtoul(optarg, NULL, 10); break;
+        case 'p': g_cfg.pool = (size_t)strtoul(optarg, NULL, 10); break;
+        case 'o': g_cfg.op = parse_op(optarg); break;
+        default: usage(argv[0]); return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (!g_cfg.conns || !g_cfg.requests || !g_cfg.depth || !g_cfg.size || !g_cfg.pool) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    client *clients = (client *)calloc(g_cfg.conns, sizeof(client));
+    pthread_t *threads = (pthread_t *)malloc(g_cfg.conns * sizeof(pthread_t));
+    if (!clients || !threads) return 1;
+
+    const double t0 = la_proto_now_us();
+    for (size_t c = 0; c < g_cfg.conns; c++) {
+        clients[c].index = c;
+        clients[c].lat_us = (double *)malloc(g_cfg.requests * sizeof(double));
+        if (!clients[c].lat_us) return 1;
+        pthread_create(&threads[c], NULL, client_main, &clients[c]);
+    }
+    for (size_t c = 0; c < g_cfg.conns; c++) {
+        pthread_join(threads[c], NULL);
+    }
+    const double elapsed_s = (la_proto_now_us() - t0) / 1e6;
+
+    size_t done = 0, errors = 0;
+    for (size_t c = 0; c < g_cfg.conns; c++) {
+        done += clients[c].done;
+        errors += clients[c].errors;
+    }
+
+    double *all = (double *)malloc((done ? done : 1) * sizeof(double));
+    if (!all) return 1;
+    size_t k = 0;
+    for (size_t c = 0; c < g_cfg.conns; c++) {
+        memcpy(all + k, clients[c].lat_us, clients[c].done * sizeof(double));
+        k += clients[c].done;
+        free(clients[c].lat_us);
+    }
+    qsort(all, done, sizeof(double), cmp_double);
+
+    printf("%zu ok, %zu errors in %.3f s (%.0f req/s), %zux%zu %s\n",
+           done, errors, elapsed_s, (double)done / elapsed_s,
+           g_cfg.size, g_cfg.size, g_cfg.op ? la_proto_op_name(g_cfg.op) : "mix");
+    if (done > 0) {
+        printf("latency us: p50 %.0f  p90 %.0f  p99 %.0f  max %.0f\n",
+               all[done / 2], all[(size_t)(done * 0.9)], all[(size_t)(done * 0.99)],
+               all[done - 1]);
+    }
+
+    // Server-side view
+    int fd = la_proto_connect(g_cfg.socket_path);
+    if (fd >= 0) {
+        la_req_header h = {LA_PROTO_MAGIC, LA_OP_STATS, 0, 0, 0};
+        uint64_t id;
+        int status;
+        if (la_proto_write_full(fd, &h, sizeof(h))) recv_response(fd, &id, &status);
+        close(fd);
+    }
+
+    free(all);
+    free(clients);
+    free(threads);
+    return errors ? 1 : 0;
+}
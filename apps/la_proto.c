@@ -0,0 +1,87 @@
+#define _POSIX_C_SOURCE 200809L  // clock_gettime
+#include "la_proto.h"
+
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+const char *la_proto_op_name(uint32_t op) {
+    switch (op) {
+    case LA_OP_MUL: return "mul";
+    case LA_OP_SOLVE: return "solve";
+    case LA_OP_DET: return "det";
+    case LA_OP_INVERSE: return "inverse";
+    case LA_OP_STATS: return "stats";
+    default: return "unknown";
+    }
+}
+
+int la_proto_read_full(int fd, void *buf, size_t n) {
+    char *p = (char *)buf;
+    while (n > 0) {
+        ssize_t k = recv(fd, p, n, 0);
+        if (k < 0 && errno == EINTR) continue;
+        if (k <= 0) return 0;
+        p += k;
+        n -= (size_t)k;
+    }
+    return 1;
+}
+
+int la_proto_write_full(int fd, const void *buf, size_t n) {
+    const char *p = (const char *)buf;
+    while (n > 0) {
+        // MSG_NOSIGNAL: a vanished peer is an error, not a SIGPIPE
+        ssize_t k = send(fd, p, n, MSG_NOSIGNAL);
+        if (k < 0 && errno == EINTR) continue;
+        if (k <= 0) return 0;
+        p += k;
+        n -= (size_t)k;
+    }
+    return 1;
+}
+
+int la_proto_send_matrix(int fd, const Matrix *m) {
+    uint64_t dims[2] = {m->rows, m->cols};
+    if (!la_proto_write_full(fd, dims, sizeof(dims))) return 0;
+    return la_proto_write_full(fd, m->data, m->rows * m->cols * sizeof(double));
+}
+
+int la_proto_recv_matrix(int fd, Matrix *m) {
+    uint64_t dims[2];
+    if (!la_proto_read_full(fd, dims, sizeof(dims))) return 0;
+    if (dims[0] == 0 || dims[1] == 0) return 0;
+    if (dims[0] > LA_PROTO_MAX_ELEMS || dims[1] > LA_PROTO_MAX_ELEMS / dims[0]) return 0;
+
+    if (la_matrix_init(m, (size_t)dims[0], (size_t)dims[1]) != LA_OK) return 0;
+    if (!la_proto_read_full(fd, m->data, m->rows * m->cols * sizeof(double))) {
+        la_matrix_free(m);
+        return 0;
+    }
+    return 1;
+}
+
+int la_proto_connect(const char *path) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) return -1;
+    strcpy(addr.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+double la_proto_now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec / 1e3;
+}
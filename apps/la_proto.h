@@ -0,0 +1,66 @@
+#ifndef LA_PROTO_H
+#define LA_PROTO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "la_matrix.h"
+
+// Binary protocol between la_server and its clients over a Unix domain
+// socket. Both ends run on the same host, so fields use host byte order.
+//
+// Request:  la_req_header, then nmat matrices
+// Response: la_resp_header, then nmat matrices, then text_len bytes of text
+// Matrix:   uint64 rows, uint64 cols, rows*cols doubles (row-major)
+
+#define LA_PROTO_MAGIC 0x3153414cu  // "LAS1"
+#define LA_PROTO_DEFAULT_SOCKET "/tmp/la_server.sock"
+
+// Largest matrix (in elements) the server accepts from a request
+#define LA_PROTO_MAX_ELEMS ((uint64_t)1 << 26)
+
+typedef enum {
+  LA_OP_MUL = 1,      // A, B      -> A * B
+  LA_OP_SOLVE = 2,    // A, b      -> x
+  LA_OP_DET = 3,      // A         -> scalar
+  LA_OP_INVERSE = 4,  // A         -> A^-1
+  LA_OP_STATS = 5     // (none)    -> JSON text
+} la_proto_op;
+
+#define LA_PROTO_OP_MAX 5
+
+typedef struct {
+  uint32_t magic;
+  uint32_t op;
+  uint64_t id;
+  uint32_t nmat;
+  uint32_t reserved;
+} la_req_header;
+
+typedef struct {
+  uint32_t magic;
+  int32_t status;  // la_status
+  uint64_t id;
+  uint32_t nmat;
+  uint32_t text_len;
+  double scalar;   // determinant for LA_OP_DET
+} la_resp_header;
+
+const char *la_proto_op_name(uint32_t op);
+
+// Blocking I/O helpers. Return 1 on success, 0 on EOF or error.
+int la_proto_read_full(int fd, void *buf, size_t n);
+int la_proto_write_full(int fd, const void *buf, size_t n);
+
+int la_proto_send_matrix(int fd, const Matrix *m);
+
+// Allocates m (which must be empty); rejects shapes above LA_PROTO_MAX_ELEMS.
+int la_proto_recv_matrix(int fd, Matrix *m);
+
+// Connects to the server socket; returns the fd or -1.
+int la_proto_connect(const char *path);
+
+// Monotonic clock in microseconds
+double la_proto_now_us(void);
+
+#endif
@@ -0,0 +1,531 @@
+#define _POSIX_C_SOURCE 200809L  // sigaction, getopt
+#include <errno.h>
+#include <math.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "la_cache.h"
+#include "la_matrix.h"
+#include "la_ops.h"
+#include "la_proto.h"
+
+// Long-lived solver service: connection threads parse requests into a
+// shared queue, a pool of workers drains it. Small requests of the same op
+// on the same A are taken from the queue together and computed once: mul
+// and solve on their right-hand sides side by side, det and inverse a
+// single time for the group. LU factors are cached by matrix content, so
+// repeated A's skip the O(n^3) step.
+
+#define HIST_BUCKETS 32      // log2 microsecond buckets
+#define BATCH_SMALL_ELEMS 4096  // only batch problems up to 64 x 64
+
+// ---------------- Requests and connections ----------------
+
+typedef struct {
+  int fd;
+  pthread_mutex_t wlock;  // one response at a time on the socket
+  atomic_int refs;        // reader thread + queued requests
+} conn;
+
+typedef struct request {
+  conn *c;
+  uint32_t op;
+  uint64_t id;
+  uint32_t nmat;
+  Matrix m[2];
+  double t_recv_us;
+  struct request *next;
+} request;
+
+static void conn_release(conn *c) {
+    if (atomic_fetch_sub(&c->refs, 1) == 1) {
+        close(c->fd);
+        pthread_mutex_destroy(&c->wlock);
+        free(c);
+    }
+}
+
+static void request_free(request *r) {
+    la_matrix_free(&r->m[0]);
+    la_matrix_free(&r->m[1]);
+    conn_release(r->c);
+    free(r);
+}
+
+// ---------------- Server state ----------------
+
+typedef struct {
+  atomic_ullong count;
+  atomic_ullong sum_us;
+  atomic_ullong buckets[HIST_BUCKETS];
+} latency_hist;
+
+static struct {
+  const char *socket_path;
+  size_t workers;
+  size_t batch_max;
+
+  pthread_mutex_t qlock;
+  pthread_cond_t qcond;
+  request *head, *tail;
+  int stopping;
+
+  latency_hist hist[LA_PROTO_OP_MAX + 1];
+  atomic_ullong batches;
+  atomic_ullong batched_requests;
+
+  la_factor_cache *cache;
+  size_t cache_mb;
+} g_srv;
+
+static volatile sig_atomic_t g_stop = 0;
+
+static void on_signal(int sig) {
+    (void)sig;
+    g_stop = 1;
+}
+
+static void hist_record(uint32_t op, double us) {
+    latency_hist *h = &g_srv.hist[op];
+    unsigned long long v = (us > 0.0) ? (unsigned long long)us : 0;
+    size_t b = 0;
+    while (b + 1 < HIST_BUCKETS && (v >> (b + 1)) != 0) b++;
+
+    atomic_fetch_add(&h->count, 1);
+    atomic_fetch_add(&h->sum_us, v);
+    atomic_fetch_add(&h->buckets[b], 1);
+}
+
+// Upper bound (us) of the bucket holding quantile q
+static unsigned long long hist_quantile(const latency_hist *h, double q) {
+    unsigned long long total = atomic_load(&h->count);
+    if (total == 0) return 0;
+    unsigned long long want = (unsigned long long)ceil(q * (double)total);
+    unsigned long long seen = 0;
+    for (size_t b = 0; b < HIST_BUCKETS; b++) {
+        seen += atomic_load(&h->buckets[b]);
+        if (seen >= want) return 2ull << b;
+    }
+    return 2ull << (HIST_BUCKETS - 1);
+}
+
+// ---------------- Request processing ----------------
+
+static int write_stats(char **text_out) {
+    size_t cap = 8192;
+    char *buf = (char *)malloc(cap);
+    if (!buf) return 0;
+
+    size_t len = 0;
+    len += (size_t)snprintf(buf + len, cap - len, "{\"ops\": {");
+    for (uint32_t op = 1; op <= LA_PROTO_OP_MAX; op++) {
+        const latency_hist *h = &g_srv.hist[op];
+        unsigned long long cnt = atomic_load(&h->count);
+        double mean = cnt ? (double)atomic_load(&h->sum_us) / (double)cnt : 0.0;
+        len += (size_t)snprintf(buf + len, cap - len,
+                                "%s\"%s\": {\"count\": %llu, \"mean_us\": %.1f, "
+                                "\"p50_us\": %llu, \"p90_us\": %llu, \"p99_us\": %llu}",
+                                op > 1 ? ", " : "", la_proto_op_name(op), cnt, mean,
+                                hist_quantile(h, 0.50), hist_quantile(h, 0.90),
+                                hist_quantile(h, 0.99));
+    }
+
+    la_cache_stats cs;
+    la_cache_get_stats(g_srv.cache, &cs);
+    len += (size_t)snprintf(buf + len, cap - len,
+                            "}, \"cache\": {\"entries\": %zu, \"bytes\": %zu, \"hits\": %llu, "
+                            "\"misses\": %llu, \"evictions\": %llu}",
+                            cs.entries, cs.bytes, cs.hits, cs.misses, cs.evictions);
+
+    len += (size_t)snprintf(buf + len, cap - len,
+                            ", \"batches\": {\"count\": %llu, \"requests\": %llu}}\n",
+                            atomic_load(&g_srv.batches), atomic_load(&g_srv.batched_requests));
+
+    *text_out = buf;
+    return 1;
+}
+
+// Runs r; out, *scalar and *text receive whichever result the op has
+static la_status compute(const request *r, Matrix *out, double *scalar, char **text) {
+    la_status st = LA_ERR_DIM;
+
+    switch (r->op) {
+    case LA_OP_MUL:
+        if (r->nmat == 2) st = la_mul(out, &r->m[0], &r->m[1]);
+        break;
+    case LA_OP_SOLVE:
+        if (r->nmat == 2 && r->m[0].rows == r->m[0].cols && r->m[1].rows == r->m[0].rows) {
+            st = la_cache_solve(g_srv.cache, out, &r->m[0], &r->m[1]);
+        }
+        break;
+    case LA_OP_DET:
+        if (r->nmat == 1 && r->m[0].rows == r->m[0].cols) {
+            st = la_cache_det(g_srv.cache, scalar, &r->m[0]);
+        }
+        break;
+    case LA_OP_INVERSE:
+        if (r->nmat == 1 && r->m[0].rows == r->m[0].cols) {
+            Matrix I = (Matrix){0};
+            st = la_matrix_init(&I, r->m[0].rows, r->m[0].rows);
+            if (st == LA_OK) {
+                la_matrix_fill(&I, 0.0);
+                for (size_t i = 0; i < I.rows; i++) LA_AT(&I, i, i) = 1.0;
+                st = la_cache_solve(g_srv.cache, out, &r->m[0], &I);
+            }
+            la_matrix_free(&I);
+        }
+        break;
+    case LA_OP_STATS:
+        st = write_stats(text) ? LA_OK : LA_ERR_ALLOC;
+        break;
+    default:
+        break;
+    }
+    return st;
+}
+
+static void respond(const request *r, la_status st, const Matrix *out, double scalar,
+                    const char *text) {
+    la_resp_header resp = {LA_PROTO_MAGIC, (int32_t)st, r->id, 0, 0, scalar};
+    if (st == LA_OK && out && out->data) resp.nmat = 1;
+    if (text) resp.text_len = (uint32_t)strlen(text);
+
+    pthread_mutex_lock(&r->c->wlock);
+    int ok = la_proto_write_full(r->c->fd, &resp, sizeof(resp));
+    if (ok && resp.nmat) ok = la_proto_send_matrix(r->c->fd, out);
+    if (ok && text) la_proto_write_full(r->c->fd, text, resp.text_len);
+    pthread_mutex_unlock(&r->c->wlock);
+
+    hist_record(r->op, la_proto_now_us() - r->t_recv_us);
+}
+
+static void process(const request *r) {
+    Matrix out = (Matrix){0};
+    double scalar = 0.0;
+    char *text = NULL;
+
+    la_status st = compute(r, &out, &scalar, &text);
+    respond(r, st, &out, scalar, text);
+
+    free(text);
+    la_matrix_free(&out);
+}
+
+// Mul and solve on a shared A: one call on [B_1 ... B_nb], then each
+// request gets its own columns back. Returns 0 if the batch could not be
+// formed and must be run request by request.
+static int process_stacked(request **batch, size_t nb) {
+    const size_t rows = batch[0]->m[1].rows;
+    size_t cols = 0;
+    for (size_t i = 0; i < nb; i++) cols += batch[i]->m[1].cols;
+
+    request stacked = *batch[0];
+    stacked.m[1] = (Matrix){0};
+    if (la_matrix_init(&stacked.m[1], rows, cols) != LA_OK) return 0;
+    for (size_t i = 0, c0 = 0; i < nb; c0 += batch[i]->m[1].cols, i++) {
+        const Matrix *b = &batch[i]->m[1];
+        for (size_t r = 0; r < rows; r++) {
+            memcpy(&LA_AT(&stacked.m[1], r, c0), &LA_AT(b, r, 0), b->cols * sizeof(double));
+        }
+    }
+
+    Matrix out = (Matrix){0};
+    double scalar = 0.0;
+    char *text = NULL;
+    la_status st = compute(&stacked, &out, &scalar, &text);
+    la_matrix_free(&stacked.m[1]);
+
+    for (size_t i = 0, c0 = 0; i < nb; c0 += batch[i]->m[1].cols, i++) {
+        Matrix part = (Matrix){0};
+        la_status pst = st;
+        if (pst == LA_OK) pst = la_matrix_init(&part, out.rows, batch[i]->m[1].cols);
+        if (pst == LA_OK) {
+            for (size_t r = 0; r < out.rows; r++) {
+                memcpy(&LA_AT(&part, r, 0), &LA_AT(&out, r, c0), part.cols * sizeof(double));
+            }
+        }
+        respond(batch[i], pst, &part, scalar, NULL);
+        la_matrix_free(&part);
+    }
+    la_matrix_free(&out);
+    return 1;
+}
+
+// Runs a batch taken by dequeue_batch; every member shares op and A
+static void process_batch(request **batch, size_t nb) {
+    if (nb == 1) {
+        process(batch[0]);
+        return;
+    }
+    if (batch[0]->op == LA_OP_MUL || batch[0]->op == LA_OP_SOLVE) {
+        if (!process_stacked(batch, nb)) {
+            for (size_t i = 0; i < nb; i++) process(batch[i]);
+        }
+        return;
+    }
+
+    // det and inverse depend on A alone
+    Matrix out = (Matrix){0};
+    double scalar = 0.0;
+    char *text = NULL;
+    la_status st = compute(batch[0], &out, &scalar, &text);
+    for (size_t i = 0; i < nb; i++) {
+        respond(batch[i], st, &out, scalar, text);
+    }
+    free(text);
+    la_matrix_free(&out);
+}
+
+// ---------------- Queue and workers ----------------
+
+// Same op, same shapes and the same A, so process_batch can share the work
+static int same_operand(const request *a, const request *b) {
+    if (a->op != b->op || a->nmat != b->nmat) return 0;
+    for (uint32_t i = 0; i < a->nmat; i++) {
+        if (a->m[i].rows != b->m[i].rows || a->m[i].cols != b->m[i].cols) return 0;
+    }
+    return memcmp(a->m[0].data, b->m[0].data,
+                  a->m[0].rows * a->m[0].cols * sizeof(double)) == 0;
+}
+
+static int is_small(const request *r) {
+    return r->nmat > 0 && r->m[0].rows * r->m[0].cols <= BATCH_SMALL_ELEMS;
+}
+
+static void enqueue(request *r) {
+    pthread_mutex_lock(&g_srv.qlock);
+    r->next = NULL;
+    if (g_srv.tail) g_srv.tail->next = r;
+    else g_srv.head = r;
+    g_srv.tail = r;
+    pthread_cond_signal(&g_srv.qcond);
+    pthread_mutex_unlock(&g_srv.qlock);
+}
+
+// Pops the oldest request plus up to batch_max - 1 queued requests with the
+// same op, shapes and A (small problems only); everything else stays queued
+// for the other workers. Returns the batch size.
+static size_t dequeue_batch(request **batch) {
+    pthread_mutex_lock(&g_srv.qlock);
+    while (!g_srv.head && !g_srv.stopping) {
+        pthread_cond_wait(&g_srv.qcond, &g_srv.qlock);
+    }
+    if (!g_srv.head) {
+        pthread_mutex_unlock(&g_srv.qlock);
+        return 0;
+    }
+
+    request *first = g_srv.head;
+    g_srv.head = first->next;
+    if (!g_srv.head) g_srv.tail = NULL;
+    batch[0] = first;
+    size_t nb = 1;
+
+    if (is_small(first)) {
+        request *prev = NULL;
+        request *r = g_srv.head;
+        while (r && nb < g_srv.batch_max) {
+            request *next = r->next;
+            if (same_operand(first, r)) {
+                if (prev) prev->next = next;
+                else g_srv.head = next;
+                if (g_srv.tail == r) g_srv.tail = prev;
+                batch[nb++] = r;
+            } else {
+                prev = r;
+            }
+            r = next;
+        }
+    }
+    pthread_mutex_unlock(&g_srv.qlock);
+    return nb;
+}
+
+static void *worker_main(void *arg) {
+    (void)arg;
+    request **batch = (request **)malloc(g_srv.batch_max * sizeof(request *));
+    if (!batch) return NULL;
+
+    for (;;) {
+        size_t nb = dequeue_batch(batch);
+        if (nb == 0) break;
+
+        if (nb > 1) {
+            atomic_fetch_add(&g_srv.batches, 1);
+            atomic_fetch_add(&g_srv.batched_requests, nb);
+        }
+        process_batch(batch, nb);
+        for (size_t i = 0; i < nb; i++) {
+            request_free(batch[i]);
+        }
+    }
+    free(batch);
+    return NULL;
+}
+
+// ---------------- Connections ----------------
+
+static void *conn_main(void *arg) {
+    conn *c = (conn *)arg;
+
+    for (;;) {
+        la_req_header h;
+        if (!la_proto_read_full(c->fd, &h, sizeof(h))) break;
+        if (h.magic != LA_PROTO_MAGIC || h.nmat > 2) break;
+
+        request *r = (request *)calloc(1, sizeof(request));
+        if (!r) break;
+        r->c = c;
+        r->op = h.op;
+        r->id = h.id;
+        r->nmat = h.nmat;
+
+        int ok = 1;
+        for (uint32_t i = 0; i < h.nmat && ok; i++) {
+            ok = la_proto_recv_matrix(c->fd, &r->m[i]);
+        }
+        if (!ok || h.op == 0 || h.op > LA_PROTO_OP_MAX) {
+            la_matrix_free(&r->m[0]);
+            la_matrix_free(&r->m[1]);
+            free(r);
+            break;
+        }
+
+        r->t_recv_us = la_proto_now_us();
+        atomic_fetch_add(&c->refs, 1);
+        enqueue(r);
+    }
+
+    // Let queued responses finish; the last reference closes the socket
+    shutdown(c->fd, SHUT_RD);
+    conn_release(c);
+    return NULL;
+}
+
+static int listen_on(const char *path) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) return -1;
+    strcpy(addr.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+
+    unlink(path);
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, 64) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void usage(const char *prog) {
+    printf("Usage: %s [-s socket] [-w workers] [-c cache_mb] [-b batch_max]\n", prog);
+}
+
+int main(int argc, char **argv) {
+    g_srv.socket_path = LA_PROTO_DEFAULT_SOCKET;
+    g_srv.workers = 0;
+    g_srv.batch_max = 16;
+    g_srv.cache_mb = 64;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "s:w:c:b:h")) != -1) {
+        switch (opt) {
+        case 's': g_srv.socket_path = optarg; break;
+        case 'w': g_srv.workers = (size_t)strtoul(optarg, NULL, 10); break;
+        case 'c': g_srv.cache_mb = (size_t)strtoul(optarg, NULL, 10); break;
+        case 'b': g_srv.batch_max = (size_t)strtoul(optarg, NULL, 10); break;
+        default: usage(argv[0]); return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (g_srv.workers == 0) {
+        long n = sysconf(_SC_NPROCESSORS_ONLN);
+        g_srv.workers = (n > 0) ? (size_t)n : 1;
+    }
+    if (g_srv.batch_max == 0) g_srv.batch_max = 1;
+
+    pthread_mutex_init(&g_srv.qlock, NULL);
+    pthread_cond_init(&g_srv.qcond, NULL);
+    if (la_cache_create(&g_srv.cache, g_srv.cache_mb << 20) != LA_OK) {
+        printf("Failed to allocate cache\n");
+        return 1;
+    }
+
+    // No SA_RESTART, so accept() returns EINTR on shutdown
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    int lfd = listen_on(g_srv.socket_path);
+    if (lfd < 0) {
+        printf("Cannot listen on %s: %s\n", g_srv.socket_path, strerror(errno));
+        return 1;
+    }
+
+    pthread_t *workers = (pthread_t *)malloc(g_srv.workers * sizeof(pthread_t));
+    if (!workers) return 1;
+    for (size_t i = 0; i < g_srv.workers; i++) {
+        pthread_create(&workers[i], NULL, worker_main, NULL);
+    }
+
+    printf("la_server listening on %s (%zu workers, cache %zu MiB, batch %zu)\n",
+           g_srv.socket_path, g_srv.workers, g_srv.cache_mb, g_srv.batch_max);
+    fflush(stdout);
+
+    while (!g_stop) {
+        int cfd = accept(lfd, NULL, NULL);
+        if (cfd < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        conn *c = (conn *)calloc(1, sizeof(conn));
+        if (!c) {
+            close(cfd);
+            continue;
+        }
+        c->fd = cfd;
+        pthread_mutex_init(&c->wlock, NULL);
+        atomic_init(&c->refs, 1);
+
+        pthread_t t;
+        if (pthread_create(&t, NULL, conn_main, c) != 0) {
+            conn_release(c);
+            continue;
+        }
+        pthread_detach(t);
+    }
+
+    close(lfd);
+    unlink(g_srv.socket_path);
+
+    // Drain what is already queued, then stop the workers
+    pthread_mutex_lock(&g_srv.qlock);
+    g_srv.stopping = 1;
+    pthread_cond_broadcast(&g_srv.qcond);
+    pthread_mutex_unlock(&g_srv.qlock);
+    for (size_t i = 0; i < g_srv.workers; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    free(workers);
+
+    char *text = NULL;
+    if (write_stats(&text)) {
+        printf("%s", text);
+        free(text);
+    }
+
+    la_cache_destroy(g_srv.cache);
+    return 0;
+}
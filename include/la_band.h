@@ -0,0 +1,76 @@
+#ifndef LA_BAND_H
+#define LA_BAND_H
+
+#include "la_matrix.h"
+
+// Banded and tridiagonal systems in O(n * bw^2) time and O(n * bw) memory.
+//
+// la_band uses LAPACK band storage: column j of A is stored contiguously in
+// ab[j * ldab ...], with A(i, j) at row kl + ku + i - j. The first kl rows
+// of every column are spare room for the fill-in of the pivoted LU, so
+// ldab = 2 * kl + ku + 1 and a band can be factored in place of a copy.
+
+typedef struct {
+  size_t n;
+  size_t kl;    // sub-diagonals
+  size_t ku;    // super-diagonals
+  size_t ldab;  // 2 * kl + ku + 1
+  double *ab;   // ldab x n, column-major
+} la_band;
+
+// A(i, j) of a band, valid for j - ku <= i <= j + kl
+#define LA_BAND_AT(b, i, j) ((b)->ab[(j) * (b)->ldab + (b)->kl + (b)->ku + (i) - (j)])
+
+// Banded LU with partial pivoting (LAPACK dgbtrf layout): U has kl + ku
+// super-diagonals, L's multipliers sit below the diagonal, and row j was
+// interchanged with row ipiv[j] at step j.
+typedef struct {
+  la_band LU;
+  size_t *ipiv;
+} la_band_lu;
+
+// Allocates a zero-filled n x n band (b must be empty).
+la_status la_band_init(la_band *b, size_t n, size_t kl, size_t ku);
+void la_band_free(la_band *b);
+
+// Smallest kl / ku such that every nonzero of the square A is in the band.
+la_status la_band_bandwidth(size_t *kl_out, size_t *ku_out, const Matrix *A);
+
+// Band of a square A. Returns LA_ERR_DIM if A has nonzeros outside it.
+la_status la_band_from_matrix(la_band *out, const Matrix *A, size_t kl, size_t ku);
+
+// Dense copy of b; out is allocated n x n.
+la_status la_band_to_matrix(Matrix *out, const la_band *b);
+
+// Factor A into f (f must be zero-initialised or freed). A pivot below
+// n * DBL_EPSILON * max|a_ij| is LA_ERR_SINGULAR, as in la_lu_factor.
+la_status la_band_lu_factor(la_band_lu *f, const la_band *A);
+
+// Solve A X = B with the factors; B is n x k and X_out is allocated n x k.
+la_status la_band_lu_solve(Matrix *X_out, const la_band_lu *f, const Matrix *B);
+
+void la_band_lu_free(la_band_lu *f);
+
+// Factor and solve in one call.
+la_status la_band_solve(Matrix *X_out, const la_band *A, const Matrix *B);
+
+// Tridiagonal systems.
+//
+// dl, d and du hold the sub-, main and super-diagonal as equal-length
+// vectors: row i reads dl[i] x[i-1] + d[i] x[i] + du[i] x[i+1], so dl[0] and
+// du[n-1] are ignored. These solvers use the Thomas algorithm without
+// pivoting, which is stable for diagonally dominant or symmetric positive
+// definite matrices; use la_band_solve otherwise. A zero pivot is
+// LA_ERR_SINGULAR.
+
+// dl, d, du are n x 1; B is n x k and X_out is allocated n x k.
+la_status la_tridiag_solve(Matrix *X_out, const Matrix *dl, const Matrix *d,
+                           const Matrix *du, const Matrix *B);
+
+// m independent systems of size n, one per row: DL, D, DU and B are m x n
+// and X_out is allocated m x n. Systems are split across nthreads threads
+// (0 = online CPUs).
+la_status la_tridiag_solve_batch(Matrix *X_out, const Matrix *DL, const Matrix *D,
+                                 const Matrix *DU, const Matrix *B, size_t nthreads);
+
+#endif
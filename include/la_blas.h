@@ -0,0 +1,67 @@
+#ifndef LA_BLAS_H
+#define LA_BLAS_H
+
+#include "la_matrix.h"
+
+// BLAS-style kernels: vector operations, matrix-vector products and
+// triangular solves / multiplies. Vectors are n x 1 or 1 x n matrices.
+// Results are written in place, as in BLAS. Matrices may be row- or
+// column-major (read through strides, no copies) or tiled (through a
+// row-major copy); vectors must not be tiled.
+//
+// The kernels use AVX2/FMA when built for such a target (-DLA_NATIVE=ON)
+// and split independent work across threads for large problems.
+
+typedef enum { LA_LEFT = 0, LA_RIGHT = 1 } la_side;
+typedef enum { LA_LOWER = 0, LA_UPPER = 1 } la_uplo;
+typedef enum { LA_NO_TRANS = 0, LA_TRANS = 1 } la_trans;
+typedef enum { LA_NON_UNIT = 0, LA_UNIT = 1 } la_diag;
+
+// Inner product of two vectors of equal length.
+la_status la_dot(double *out, const Matrix *x, const Matrix *y);
+
+// Euclidean norm of a vector, without overflow or underflow in the squares.
+la_status la_nrm2(double *out, const Matrix *x);
+
+// y := alpha * op(A) x + beta * y. A is m x n; x has n entries (m for
+// LA_TRANS) and y has m (n). With beta = 0, y need not be initialised.
+la_status la_gemv(la_trans trans, double alpha, const Matrix *A, const Matrix *x,
+                  double beta, Matrix *y);
+
+// Triangular kernels (trsm / trmm / trsv). Only the uplo triangle of T is
+// read; with LA_UNIT its diagonal is taken to be 1. The diagonal blocks are
+// solved first and then applied as a matrix-matrix update; independent
+// right-hand sides are split across threads.
+
+// B := alpha * op(T)^-1 B (LA_LEFT) or alpha * B op(T)^-1 (LA_RIGHT), where
+// op(T) is T or T^T. T is square and matches B's rows (left) or cols (right).
+// A zero on a non-unit diagonal gives inf / nan, as in BLAS.
+la_status la_trsm(la_side side, la_uplo uplo, la_trans trans, la_diag diag,
+                  double alpha, const Matrix *T, Matrix *B);
+
+// B := alpha * op(T) B (LA_LEFT) or alpha * B op(T) (LA_RIGHT).
+la_status la_trmm(la_side side, la_uplo uplo, la_trans trans, la_diag diag,
+                  double alpha, const Matrix *T, Matrix *B);
+
+// x := op(T)^-1 x for an n x 1 vector x.
+la_status la_trsv(la_uplo uplo, la_trans trans, la_diag diag, const Matrix *T, Matrix *x);
+
+// Threads used by the BLAS and elementwise kernels: 0 (default) = online
+// CPUs, 1 = serial.
+void la_blas_set_threads(size_t nthreads);
+
+// Deterministic mode (off by default). When on, work is split at points
+// that depend only on the problem size and partial results are combined in
+// a fixed order, so la_reduce, the BLAS and elementwise kernels and the
+// solvers built on them give bit-identical results for every thread count
+// and schedule. The AVX2 kernels also drop fused multiply-add, and libla is
+// built with -ffp-contract=off, so results match across builds (portable,
+// LA_NATIVE) and IEEE double targets (x86-64, aarch64) too. Two exceptions:
+// libm functions other than sqrt (log in la_logdet) may differ between C
+// libraries, and x87-only 32-bit builds carry excess precision. la_mul is
+// serial and the la_par_* routines run a fixed sequence of tile operations
+// on every tile, so they are reproducible in either mode.
+void la_set_deterministic(int on);
+int la_get_deterministic(void);
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef LA_CACHE_H
+#define LA_CACHE_H
+
+#include "la_matrix.h"
+
+// LRU cache of LU factorizations keyed by the shape and contents of A, so
+// repeated solves against a recurring matrix cost O(n^2) instead of O(n^3).
+//
+// Lookups hash A and then compare it against a stored copy, so a hit is
+// always exact. The copy counts toward max_bytes along with the factors.
+// Singular matrices are cached as well (without factors), so repeating one
+// returns LA_ERR_SINGULAR straight away.
+// All functions are thread-safe.
+
+typedef struct la_factor_cache la_factor_cache;
+
+typedef struct {
+  unsigned long long hits;
+  unsigned long long misses;
+  unsigned long long evictions;
+  size_t entries;
+  size_t bytes;      // memory held by cached entries
+  size_t max_bytes;
+} la_cache_stats;
+
+la_status la_cache_create(la_factor_cache **out, size_t max_bytes);
+
+// Frees the cache. It must not be installed or in use by any thread.
+void la_cache_destroy(la_factor_cache *c);
+
+// Drops every entry not currently in use. Statistics are kept.
+void la_cache_clear(la_factor_cache *c);
+
+la_status la_cache_get_stats(la_factor_cache *c, la_cache_stats *out);
+
+// Solve A X = B through the cache. B is n x k; X_out is allocated n x k.
+// Factors match la_solve (pivots below 1e-12 are LA_ERR_SINGULAR).
+la_status la_cache_solve(la_factor_cache *c, Matrix *X_out, const Matrix *A,
+                         const Matrix *B);
+
+// Determinant of A through the cache.
+la_status la_cache_det(la_factor_cache *c, double *det_out, const Matrix *A);
+
+// Opt-in transparent caching: while c is installed, la_solve, la_det and
+// la_inverse look up and populate it. Pass NULL to turn caching off.
+void la_set_factor_cache(la_factor_cache *c);
+
+la_factor_cache *la_get_factor_cache(void);
+
+#endif
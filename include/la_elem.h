@@ -0,0 +1,39 @@
+#ifndef LA_ELEM_H
+#define LA_ELEM_H
+
+#include "la_matrix.h"
+
+// Elementwise and broadcast operations. Loops run over contiguous memory so
+// they vectorise, and large matrices are split by rows across the threads
+// set with la_blas_set_threads. Operands that share a row- or column-major
+// layout are processed in place and the result keeps that layout; other
+// mixes give a row-major result.
+
+typedef enum {
+  LA_ELEM_ADD = 0,
+  LA_ELEM_SUB,
+  LA_ELEM_MUL,
+  LA_ELEM_DIV
+} la_elem_op;
+
+// out = alpha * a
+la_status la_scale(Matrix *out, double alpha, const Matrix *a);
+
+// y += alpha * x, in place; x and y have the same shape.
+la_status la_axpy(Matrix *y, double alpha, const Matrix *x);
+
+// out = a .* b and out = a ./ b (same shapes)
+la_status la_hadamard(Matrix *out, const Matrix *a, const Matrix *b);
+la_status la_divide(Matrix *out, const Matrix *a, const Matrix *b);
+
+// out(i, j) = a(i, j) op row(j), with row 1 x a.cols
+la_status la_bcast_row(Matrix *out, const Matrix *a, const Matrix *row, la_elem_op op);
+
+// out(i, j) = a(i, j) op col(i), with col a.rows x 1
+la_status la_bcast_col(Matrix *out, const Matrix *a, const Matrix *col, la_elem_op op);
+
+// Kronecker product: out is (a.rows * b.rows) x (a.cols * b.cols). Each
+// output row is written once, front to back, from one row of b.
+la_status la_kron(Matrix *out, const Matrix *a, const Matrix *b);
+
+#endif
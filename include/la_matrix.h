@@ -3,26 +3,78 @@
 
 #include <stddef.h> // size_t
 
+// Storage order of Matrix.data. Outputs allocated by the library are
+// row-major unless a function says otherwise.
+typedef enum {
+  LA_ROW_MAJOR = 0,  // data[i*cols + j]
+  LA_COL_MAJOR = 1,  // data[j*rows + i], as in Fortran / LAPACK
+  LA_TILED = 2       // b x b row-major tiles in row-major tile order; the
+                     // edge tiles are zero-padded to full size
+} la_layout;
+
+// Tile edge used when LA_TILED is requested with tile = 0
+#define LA_TILE_DEFAULT 64
+
 typedef struct {
   size_t rows;
   size_t cols;
-  double *data; // row-major contiguous: data[i*cols + j]
+  double *data;      // contiguous, in the order given by layout
+  la_layout layout;  // a zero-initialised Matrix is row-major
+  size_t tile;       // tile edge b for LA_TILED, 0 otherwise
+  int borrowed;      // data is owned by the caller (la_matrix_wrap)
 } Matrix;
 
 typedef enum {
   LA_OK = 0,
   LA_ERR_DIM = 1,
   LA_ERR_ALLOC = 2,
-  LA_ERR_SINGULAR = 3
+  LA_ERR_SINGULAR = 3,
+  LA_ERR_IO = 4
 } la_status;
 
+// Entry (i, j) of a row-major matrix
 #define LA_AT(m, i, j) ((m)->data[(i) * (m)->cols + (j)])
 
+// Offset of entry (i, j) in m->data for any layout
+static inline size_t la_matrix_offset(const Matrix *m, size_t i, size_t j) {
+    switch (m->layout) {
+    case LA_COL_MAJOR:
+        return j * m->rows + i;
+    case LA_TILED: {
+        const size_t b = m->tile;
+        const size_t tc = (m->cols + b - 1) / b;
+        return ((i / b) * tc + j / b) * b * b + (i % b) * b + j % b;
+    }
+    default:
+        return i * m->cols + j;
+    }
+}
+
+// Entry (i, j) of a matrix in any layout
+#define LA_REF(m, i, j) ((m)->data[la_matrix_offset((m), (i), (j))])
+
 // Lifecycle
 la_status la_matrix_init(Matrix *m, size_t rows, size_t cols);
 void la_matrix_free(Matrix *m);
 
-// Utilities
+// Allocates m with the given layout; tile is the tile edge for LA_TILED
+// (0 = LA_TILE_DEFAULT) and is ignored otherwise. Tile padding is zeroed.
+la_status la_matrix_init_layout(Matrix *m, size_t rows, size_t cols, la_layout layout,
+                                size_t tile);
+
+// Wraps caller-owned data without copying, e.g. a column-major array from
+// Fortran or LAPACK. la_matrix_free only resets m; data stays the caller's.
+// LA_TILED data must hold zeros in the tile padding.
+la_status la_matrix_wrap(Matrix *m, size_t rows, size_t cols, double *data,
+                         la_layout layout, size_t tile);
+
+// dst = src stored in the given layout (dst must be empty)
+la_status la_matrix_convert(Matrix *dst, const Matrix *src, la_layout layout, size_t tile);
+
+// Number of doubles in m->data, including any tile padding
+size_t la_matrix_storage(const Matrix *m);
+
+// Utilities; la_matrix_copy keeps src's layout, and the copy owns its data
 la_status la_matrix_copy(Matrix *dst, const Matrix *src);
 void la_matrix_fill(Matrix *m, double value);
 
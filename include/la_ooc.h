@@ -0,0 +1,59 @@
+#ifndef LA_OOC_H
+#define LA_OOC_H
+
+#include "la_matrix.h"
+
+// Out-of-core dense matrices.
+//
+// An la_ooc_matrix lives in a file as square tiles of tile x tile doubles
+// (edge tiles are padded), stored tile-major so every tile is one pread /
+// pwrite. At most cache_tiles tiles are held in memory at a time (LRU) and a
+// background thread prefetches the tiles a kernel will touch next, so I/O
+// overlaps with compute.
+
+typedef struct la_ooc_matrix la_ooc_matrix;
+
+typedef struct {
+  unsigned long long hits;
+  unsigned long long misses;
+  unsigned long long prefetches;
+  unsigned long long tile_reads;
+  unsigned long long tile_writes;
+} la_ooc_stats;
+
+// Smallest cache the kernels below can run with
+#define LA_OOC_MIN_CACHE_TILES 4
+
+// Creates (or truncates) the backing file at path and zero-fills it.
+la_status la_ooc_create(la_ooc_matrix **out, const char *path, size_t rows,
+                        size_t cols, size_t tile, size_t cache_tiles);
+
+// Opens an existing backing file previously written with the same shape.
+la_status la_ooc_open(la_ooc_matrix **out, const char *path, size_t rows,
+                      size_t cols, size_t tile, size_t cache_tiles);
+
+// Writes back dirty tiles, stops the prefetch thread and frees m. The
+// backing file is kept. Returns LA_ERR_IO if any tile I/O failed.
+la_status la_ooc_close(la_ooc_matrix *m);
+
+la_status la_ooc_flush(la_ooc_matrix *m);
+
+// Copy the block src into m at (row0, col0).
+la_status la_ooc_write_block(la_ooc_matrix *m, size_t row0, size_t col0, const Matrix *src);
+
+// Read a rows x cols block starting at (row0, col0); dst is allocated.
+la_status la_ooc_read_block(Matrix *dst, la_ooc_matrix *m, size_t row0, size_t col0,
+                            size_t rows, size_t cols);
+
+la_status la_ooc_get_stats(la_ooc_matrix *m, la_ooc_stats *out);
+
+// C = A * B. All three must share the same tile size; C must already have
+// shape A.rows x B.cols.
+la_status la_ooc_mul(la_ooc_matrix *C, la_ooc_matrix *A, la_ooc_matrix *B);
+
+// Solve A X = B with blocked LU and partial pivoting. A is overwritten by
+// its factors. B is an in-memory n x k matrix; X_out is allocated n x k.
+// Returns LA_ERR_SINGULAR, like la_solve, for pivots below 1e-12.
+la_status la_ooc_solve(Matrix *X_out, la_ooc_matrix *A, const Matrix *B);
+
+#endif
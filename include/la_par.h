@@ -0,0 +1,35 @@
+#ifndef LA_PAR_H
+#define LA_PAR_H
+
+#include "la_matrix.h"
+#include "la_solve.h"
+
+// Tiled, multithreaded versions of the dense routines. Each factorization is
+// expressed as a graph of tile kernels (panel, triangular solve, GEMM update)
+// that a pool of threads executes as soon as their inputs are ready, so the
+// next panel overlaps the trailing update of the current one.
+
+typedef struct {
+  size_t nthreads;   // 0 = number of online CPUs
+  size_t tile;       // tile edge; 0 = 128
+  size_t lookahead;  // tile columns ahead of the current panel that are
+                     // prioritised so the next panels start early; 0 = 1
+  double pivot_tol;  // as in la_solve_opts (LU only)
+} la_par_opts;
+
+// out = a * b
+la_status la_par_mul(Matrix *out, const Matrix *a, const Matrix *b, const la_par_opts *opts);
+
+// Same factorization as la_lu_factor (P A = L U), computed tile-parallel.
+la_status la_par_lu_factor(la_lu *f, const Matrix *A, const la_par_opts *opts);
+
+// Cholesky factor of a symmetric positive definite A (lower triangle is
+// read): A = L L^T. Returns LA_ERR_SINGULAR if A is not positive definite.
+la_status la_par_cholesky(Matrix *L_out, const Matrix *A, const la_par_opts *opts);
+
+// la_det and la_solve on top of la_par_lu_factor. Singularity is judged
+// with the relative pivot threshold of la_solve_ex.
+la_status la_par_det(double *det_out, const Matrix *A, const la_par_opts *opts);
+la_status la_par_solve(Matrix *x_out, const Matrix *A, const Matrix *b, const la_par_opts *opts);
+
+#endif
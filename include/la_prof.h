@@ -0,0 +1,57 @@
+#ifndef LA_PROF_H
+#define LA_PROF_H
+
+#include <stdio.h>  // FILE
+
+#include "la_matrix.h"
+
+// Per-operation instrumentation. Counters are only collected when the
+// library is built with -DLA_PROFILE=ON; otherwise the hooks compile away
+// and every query reports zeros.
+//
+// Counters are inclusive: an operation that calls another public one (for
+// example la_solve and la_inverse going through la_lu_solve) records the
+// inner call under its own name as well, so per-operation times do not add
+// up to the total. Hardware counters are opened per thread and closed when
+// the thread exits.
+
+typedef enum {
+  LA_PROF_ADD = 0,
+  LA_PROF_SUB,
+  LA_PROF_TRANSPOSE,
+  LA_PROF_MUL,
+  LA_PROF_DET,
+  LA_PROF_SOLVE,
+  LA_PROF_INVERSE,
+  LA_PROF_LU_FACTOR,
+  LA_PROF_LU_SOLVE,
+  LA_PROF_OP_COUNT
+} la_prof_op;
+
+typedef struct {
+  unsigned long long calls;
+  unsigned long long bytes_alloc;   // bytes allocated by the call (incl. temporaries)
+  unsigned long long time_ns;       // wall time
+  unsigned long long flops;         // nominal flop count (LAPACK conventions)
+  unsigned long long cache_misses;  // hardware counters; 0 when unavailable
+  unsigned long long cycles;
+  unsigned long long instructions;
+} la_prof_stats;
+
+// 1 if instrumentation was compiled in.
+int la_prof_enabled(void);
+
+// 1 if Linux perf_event hardware counters could be opened on this thread.
+int la_prof_hw_available(void);
+
+const char *la_prof_op_name(la_prof_op op);
+
+// Snapshot of the accumulated counters for one operation.
+la_status la_prof_get(la_prof_op op, la_prof_stats *out);
+
+void la_prof_reset(void);
+
+// Writes all counters as a JSON object.
+la_status la_prof_dump_json(FILE *fp);
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef LA_REDUCE_H
+#define LA_REDUCE_H
+
+#include "la_matrix.h"
+
+// Reductions over the entries of a matrix. la_reduce computes any mix of
+// the statistics below in a single sweep over memory, so asking for several
+// costs about the same as asking for one. Large matrices are split by rows
+// across the threads set with la_blas_set_threads. Sums are taken in short
+// SIMD blocks whose totals are added with compensated summation, so their
+// error does not grow with the size of the matrix. Column-major matrices
+// are reduced in place; tiled ones through a row-major copy.
+
+typedef enum {
+  LA_STAT_SUM      = 1u << 0,
+  LA_STAT_FRO      = 1u << 1,  // Frobenius norm
+  LA_STAT_NORM1    = 1u << 2,  // largest column sum of |a|
+  LA_STAT_NORMINF  = 1u << 3,  // largest row sum of |a|
+  LA_STAT_MAXABS   = 1u << 4,
+  LA_STAT_MIN      = 1u << 5,
+  LA_STAT_MAX      = 1u << 6,
+  LA_STAT_TRACE    = 1u << 7,  // square only; alone, reads just the diagonal
+  LA_STAT_ROW_SUMS = 1u << 8,  // into la_stats.row_sums
+  LA_STAT_COL_SUMS = 1u << 9   // into la_stats.col_sums
+} la_stat;
+
+typedef struct {
+  double sum;
+  double fro;
+  double norm1;
+  double norminf;
+  double maxabs;
+  double min;
+  double max;
+  double trace;
+  double *row_sums;  // caller-owned, A.rows entries
+  double *col_sums;  // caller-owned, A.cols entries
+} la_stats;
+
+// Fills the members of st selected by the LA_STAT_* bits in which; the
+// others are left alone. Results go into st and its caller-owned arrays.
+// On row-major input, scalar and row statistics use no heap memory. Column
+// statistics (LA_STAT_NORM1, LA_STAT_COL_SUMS) allocate 4 * A.cols doubles
+// per row partition, with up to 64 partitions set by the matrix size (and,
+// outside deterministic mode, the thread count). Column-major input swaps
+// the two, so its row statistics allocate 4 * A.rows doubles per partition.
+// Tiled input is first copied to row-major: A.rows * A.cols doubles.
+la_status la_reduce(la_stats *st, const Matrix *A, unsigned which);
+
+// Single statistics, each one sweep of la_reduce.
+la_status la_norm_fro(double *out, const Matrix *A);
+la_status la_norm_1(double *out, const Matrix *A);
+la_status la_norm_inf(double *out, const Matrix *A);
+la_status la_max_abs(double *out, const Matrix *A);
+la_status la_trace(double *out, const Matrix *A);
+
+// out = A.rows x 1 row sums / 1 x A.cols column sums
+la_status la_row_sums(Matrix *out, const Matrix *A);
+la_status la_col_sums(Matrix *out, const Matrix *A);
+
+#endif
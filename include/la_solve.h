@@ -3,7 +3,31 @@
 
 #include "la_matrix.h"
 
-// Determinant of a square matrix A.
+// Options for the factorization-based solvers.
+typedef struct {
+  // Relative pivot threshold: a pivot is treated as zero when
+  // |pivot| < pivot_tol * max|a_ij|. A value <= 0 selects n * DBL_EPSILON.
+  double pivot_tol;
+} la_solve_opts;
+
+// Solve-quality diagnostics filled in by la_solve_ex.
+typedef struct {
+  double rcond;  // estimate of 1 / (||A||_1 * ||A^-1||_1), 0 if singular
+  double berr;   // normwise backward error ||b - Ax||_inf / (||A||_inf ||x||_inf + ||b||_inf)
+  double anorm;  // ||A||_1
+} la_solve_info;
+
+// LU factorization with partial pivoting: P A = L U.
+typedef struct {
+  Matrix LU;     // unit lower L below the diagonal, U on and above it
+  size_t *perm;  // row i of P A is row perm[i] of A
+  int sign;      // determinant of P (+1 or -1)
+  double anorm;  // ||A||_1 of the factored matrix
+} la_lu;
+
+// Determinant of a square matrix A. Like la_solve and la_inverse it treats
+// pivots below an absolute 1e-12 as zero, so a well-conditioned matrix with
+// tiny entries is reported singular; la_logdet has no such scale limit.
 // Returns LA_OK, LA_ERR_DIM, LA_ERR_ALLOC, or LA_ERR_SINGULAR.
 la_status la_det(double *det_out, const Matrix *A);
 
@@ -15,6 +39,42 @@ la_status la_det(double *det_out, const Matrix *A);
 // Returns LA_OK, LA_ERR_DIM, LA_ERR_ALLOC, or LA_ERR_SINGULAR.
 la_status la_solve(Matrix *x_out, const Matrix *A, const Matrix *b);
 
+// Same as la_solve, but uses a scale-aware pivot threshold (opts may be NULL
+// for defaults) and, when info is non-NULL, reports the reciprocal condition
+// estimate and backward error. The diagnostics reuse the LU factors and cost
+// O(n^2) on top of the O(n^3) factorization.
+la_status la_solve_ex(Matrix *x_out, const Matrix *A, const Matrix *b,
+                      const la_solve_opts *opts, la_solve_info *info);
+
 la_status la_inverse(Matrix *A_inv, const Matrix *A);
 
+// Factor a square A into f (f must be zero-initialised or freed).
+// opts may be NULL for defaults.
+la_status la_lu_factor(la_lu *f, const Matrix *A, const la_solve_opts *opts);
+
+// Solve A X = B using an existing factorization. B is n x k; X_out is
+// allocated as n x k.
+la_status la_lu_solve(Matrix *X_out, const la_lu *f, const Matrix *B);
+
+// Hager/Higham estimate of 1 / (||A||_1 * ||A^-1||_1) from the factors.
+la_status la_lu_rcond(double *rcond_out, const la_lu *f);
+
+void la_lu_free(la_lu *f);
+
+// Sign (+1 / -1) and natural log of |det A|, accumulated in log space so
+// large matrices neither overflow nor underflow. la_logdet factors with
+// la_lu_factor, or with the tiled multithreaded LU (la_par_lu_factor) from
+// order 256 on; both use the relative pivot rule of la_solve_opts, so the
+// result does not depend on the scale of A. A singular A gives sign 0,
+// log|det| = -inf and LA_ERR_SINGULAR.
+la_status la_lu_logdet(int *sign_out, double *logabs_out, const la_lu *f);
+la_status la_logdet(int *sign_out, double *logabs_out, const Matrix *A);
+
+// la_logdet for count independent square matrices, spread over nthreads
+// threads (0 = online CPUs). signs and logabs receive count entries each.
+// Returns LA_ERR_SINGULAR if any matrix was singular; the other entries
+// are still valid.
+la_status la_logdet_batch(int *signs, double *logabs, const Matrix *As, size_t count,
+                          size_t nthreads);
+
 #endif
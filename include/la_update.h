@@ -0,0 +1,27 @@
+#ifndef LA_UPDATE_H
+#define LA_UPDATE_H
+
+#include "la_matrix.h"
+#include "la_solve.h"
+
+// Low-rank modifications of an existing inverse or factorization, so a
+// system that changes by A + U V^T can be re-solved in O(n^2 k) instead of
+// refactoring at O(n^3). U and V are n x k.
+
+// A_inv := (A + U V^T)^-1 given A_inv = A^-1 (Sherman-Morrison-Woodbury).
+// Returns LA_ERR_SINGULAR, leaving A_inv unchanged, if the update makes the
+// matrix singular.
+la_status la_inverse_update(Matrix *A_inv, const Matrix *U, const Matrix *V);
+
+// Solve (A + U V^T) X = B using the factorization f of A. B is n x m and
+// X_out is allocated n x m.
+la_status la_lu_solve_update(Matrix *X_out, const la_lu *f, const Matrix *U,
+                             const Matrix *V, const Matrix *B);
+
+// L := chol(L L^T + sign * X X^T) for a lower Cholesky factor L and n x k X,
+// one rank-1 update (sign = +1) or downdate (sign = -1) per column.
+// Returns LA_ERR_SINGULAR, leaving L unchanged, if a downdate would make the
+// matrix indefinite.
+la_status la_cholesky_update(Matrix *L, const Matrix *X, int sign);
+
+#endif
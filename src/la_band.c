@@ -0,0 +1,430 @@
+#include "la_band.h"
+#include "la_matrix_internal.h"
+#include "la_prof_internal.h"
+#include "la_task.h"
+
+#include <float.h>   // DBL_EPSILON
+#include <math.h>    // fabs
+#include <stdlib.h>  // malloc, calloc, free
+#include <string.h>  // memcpy
+
+// Batched systems per task, relative to the thread count
+static const size_t LA_BATCH_TASKS_PER_THREAD = 4;
+
+static size_t min_size(size_t a, size_t b) {
+    return a < b ? a : b;
+}
+
+// ---------------- Storage ----------------
+
+la_status la_band_init(la_band *b, size_t n, size_t kl, size_t ku) {
+    if (!b || n == 0) return LA_ERR_DIM;
+    if (b->ab != NULL) return LA_ERR_DIM;
+    if (kl >= n || ku >= n) return LA_ERR_DIM;
+
+    const size_t ldab = 2 * kl + ku + 1;
+    b->ab = (double *)calloc(ldab * n, sizeof(double));
+    if (!b->ab) return LA_ERR_ALLOC;
+    LA_PROF_ALLOC(ldab * n * sizeof(double));
+
+    b->n = n;
+    b->kl = kl;
+    b->ku = ku;
+    b->ldab = ldab;
+    return LA_OK;
+}
+
+void la_band_free(la_band *b) {
+    if (!b) return;
+    free(b->ab);
+    b->ab = NULL;
+    b->n = 0;
+    b->kl = 0;
+    b->ku = 0;
+    b->ldab = 0;
+}
+
+la_status la_band_bandwidth(size_t *kl_out, size_t *ku_out, const Matrix *A) {
+    if (!kl_out || !ku_out || !A || !A->data) return LA_ERR_DIM;
+    if (A->rows != A->cols) return LA_ERR_DIM;
+
+    size_t kl = 0;
+    size_t ku = 0;
+    for (size_t i = 0; i < A->rows; i++) {
+        for (size_t j = 0; j < A->cols; j++) {
+            if (LA_REF(A, i, j) == 0.0) continue;
+            if (i > j && i - j > kl) kl = i - j;
+            if (j > i && j - i > ku) ku = j - i;
+        }
+    }
+    *kl_out = kl;
+    *ku_out = ku;
+    return LA_OK;
+}
+
+la_status la_band_from_matrix(la_band *out, const Matrix *A, size_t kl, size_t ku) {
+    if (!out || !A || !A->data) return LA_ERR_DIM;
+    if (out->ab != NULL) return LA_ERR_DIM;
+    if (A->rows != A->cols) return LA_ERR_DIM;
+
+    const size_t n = A->rows;
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            const int in_band = (i <= j + kl) && (j <= i + ku);
+            if (!in_band && LA_REF(A, i, j) != 0.0) return LA_ERR_DIM;
+        }
+    }
+
+    la_status st = la_band_init(out, n, kl, ku);
+    if (st != LA_OK) return st;
+
+    for (size_t j = 0; j < n; j++) {
+        const size_t i0 = (j > ku) ? j - ku : 0;
+        const size_t i1 = min_size(n - 1, j + kl);
+        for (size_t i = i0; i <= i1; i++) {
+            LA_BAND_AT(out, i, j) = LA_REF(A, i, j);
+        }
+    }
+    return LA_OK;
+}
+
+la_status la_band_to_matrix(Matrix *out, const la_band *b) {
+    if (!out || !b || !b->ab) return LA_ERR_DIM;
+    if (out->data != NULL) return LA_ERR_DIM;
+
+    const size_t n = b->n;
+    la_status st = la_matrix_init(out, n, n);
+    if (st != LA_OK) return st;
+    la_matrix_fill(out, 0.0);
+
+    for (size_t j = 0; j < n; j++) {
+        const size_t i0 = (j > b->ku) ? j - b->ku : 0;
+        const size_t i1 = min_size(n - 1, j + b->kl);
+        for (size_t i = i0; i <= i1; i++) {
+            LA_AT(out, i, j) = LA_BAND_AT(b, i, j);
+        }
+    }
+    return LA_OK;
+}
+
+// ---------------- Banded LU ----------------
+
+la_status la_band_lu_factor(la_band_lu *f, const la_band *A) {
+    if (!f || !A || !A->ab) return LA_ERR_DIM;
+
+    la_band_free(&f->LU);
+    free(f->ipiv);
+    f->ipiv = NULL;
+
+    const size_t n = A->n;
+    const size_t kl = A->kl;
+    const size_t kv = A->kl + A->ku;
+
+    la_status st = la_band_init(&f->LU, n, kl, A->ku);
+    if (st != LA_OK) return st;
+    memcpy(f->LU.ab, A->ab, A->ldab * n * sizeof(double));
+
+    f->ipiv = (size_t *)malloc(n * sizeof(size_t));
+    if (!f->ipiv) {
+        la_band_lu_free(f);
+        return LA_ERR_ALLOC;
+    }
+    LA_PROF_ALLOC(n * sizeof(size_t));
+
+    la_band *M = &f->LU;
+    double maxabs = 0.0;
+    for (size_t j = 0; j < n; j++) {
+        const double *col = M->ab + j * M->ldab + kl;
+        for (size_t r = 0; r <= kv; r++) {
+            if (fabs(col[r]) > maxabs) maxabs = fabs(col[r]);
+        }
+    }
+    const double tol = (double)n * DBL_EPSILON * maxabs;
+    if (maxabs == 0.0) {
+        la_band_lu_free(f);
+        return LA_ERR_SINGULAR;
+    }
+
+    // Right-looking elimination inside the band (dgbtf2). ju is the last
+    // column reached by U so far; pivoting can push it to j + kl + ku.
+    size_t ju = 0;
+    for (size_t j = 0; j < n; j++) {
+        const size_t km = min_size(kl, n - 1 - j);
+        double *colj = &LA_BAND_AT(M, j, j);  // A(j..j+km, j) is contiguous
+
+        size_t jp = 0;
+        for (size_t i = 1; i <= km; i++) {
+            if (fabs(colj[i]) > fabs(colj[jp])) jp = i;
+        }
+        f->ipiv[j] = j + jp;
+        if (fabs(colj[jp]) < tol) {
+            la_band_lu_free(f);
+            return LA_ERR_SINGULAR;
+        }
+
+        const size_t reach = min_size(j + A->ku + jp, n - 1);
+        if (reach > ju) ju = reach;
+
+        if (jp != 0) {
+            for (size_t c = j; c <= ju; c++) {
+                double tmp = LA_BAND_AT(M, j, c);
+                LA_BAND_AT(M, j, c) = LA_BAND_AT(M, j + jp, c);
+                LA_BAND_AT(M, j + jp, c) = tmp;
+            }
+        }
+
+        const double inv = 1.0 / colj[0];
+        for (size_t i = 1; i <= km; i++) {
+            colj[i] *= inv;
+        }
+
+        // Rank-1 update of the trailing band, one contiguous column at a time
+        for (size_t c = j + 1; c <= ju; c++) {
+            double *colc = &LA_BAND_AT(M, j, c);
+            const double t = colc[0];
+            if (t == 0.0) continue;
+            for (size_t i = 1; i <= km; i++) {
+                colc[i] -= colj[i] * t;
+            }
+        }
+    }
+    return LA_OK;
+}
+
+la_status la_band_lu_solve(Matrix *X_out, const la_band_lu *f, const Matrix *B) {
+    if (!X_out || !f || !B || !f->LU.ab || !f->ipiv || !B->data) return LA_ERR_DIM;
+    if (X_out->data != NULL) return LA_ERR_DIM;
+    if (B->rows != f->LU.n) return LA_ERR_DIM;
+
+    const la_band *M = &f->LU;
+    const size_t n = M->n;
+    const size_t k = B->cols;
+    const size_t kv = M->kl + M->ku;
+
+    la_status st = la_matrix_convert(X_out, B, LA_ROW_MAJOR, 0);
+    if (st != LA_OK) return st;
+
+    // L: apply each step's interchange, then its multipliers
+    for (size_t j = 0; j + 1 < n; j++) {
+        double *xj = X_out->data + j * k;
+        const size_t p = f->ipiv[j];
+        if (p != j) {
+            double *xp = X_out->data + p * k;
+            for (size_t c = 0; c < k; c++) {
+                double tmp = xj[c];
+                xj[c] = xp[c];
+                xp[c] = tmp;
+            }
+        }
+
+        const size_t km = min_size(M->kl, n - 1 - j);
+        const double *l = &LA_BAND_AT(M, j, j);
+        for (size_t i = 1; i <= km; i++) {
+            double *xi = xj + i * k;
+            for (size_t c = 0; c < k; c++) {
+                xi[c] -= l[i] * xj[c];
+            }
+        }
+    }
+
+    // U, column by column from the bottom
+    for (size_t j = n; j-- > 0;) {
+        double *xj = X_out->data + j * k;
+        const double diag = LA_BAND_AT(M, j, j);
+        for (size_t c = 0; c < k; c++) {
+            xj[c] /= diag;
+        }
+
+        const size_t i0 = (j > kv) ? j - kv : 0;
+        for (size_t i = i0; i < j; i++) {
+            const double u = LA_BAND_AT(M, i, j);
+            double *xi = X_out->data + i * k;
+            for (size_t c = 0; c < k; c++) {
+                xi[c] -= u * xj[c];
+            }
+        }
+    }
+    return LA_OK;
+}
+
+void la_band_lu_free(la_band_lu *f) {
+    if (!f) return;
+    la_band_free(&f->LU);
+    free(f->ipiv);
+    f->ipiv = NULL;
+}
+
+la_status la_band_solve(Matrix *X_out, const la_band *A, const Matrix *B) {
+    if (!X_out || !A || !B || !A->ab || !B->data) return LA_ERR_DIM;
+    if (X_out->data != NULL) return LA_ERR_DIM;
+    if (B->rows != A->n) return LA_ERR_DIM;
+
+    la_band_lu f = {0};
+    la_status st = la_band_lu_factor(&f, A);
+    if (st != LA_OK) return st;
+
+    st = la_band_lu_solve(X_out, &f, B);
+    la_band_lu_free(&f);
+    return st;
+}
+
+// ---------------- Tridiagonal ----------------
+
+// Thomas algorithm for an n x n tridiagonal system with k right-hand sides
+// (b and x are n x k row-major and may alias). cp is n doubles of scratch.
+// Returns 0 on a zero pivot.
+static int thomas(size_t n, size_t k, const double *dl, const double *d, const double *du,
+                  const double *b, double *x, double *cp) {
+    double w = d[0];
+    if (w == 0.0) return 0;
+    cp[0] = (n > 1) ? du[0] / w : 0.0;
+    for (size_t c = 0; c < k; c++) {
+        x[c] = b[c] / w;
+    }
+
+    for (size_t i = 1; i < n; i++) {
+        w = d[i] - dl[i] * cp[i - 1];
+        if (w == 0.0) return 0;
+        cp[i] = (i + 1 < n) ? du[i] / w : 0.0;
+
+        const double *bi = b + i * k;
+        const double *xp = x + (i - 1) * k;
+        double *xi = x + i * k;
+        for (size_t c = 0; c < k; c++) {
+            xi[c] = (bi[c] - dl[i] * xp[c]) / w;
+        }
+    }
+
+    for (size_t i = n - 1; i-- > 0;) {
+        double *xi = x + i * k;
+        const double *xn = x + (i + 1) * k;
+        for (size_t c = 0; c < k; c++) {
+            xi[c] -= cp[i] * xn[c];
+        }
+    }
+    return 1;
+}
+
+static int all_row_major(const Matrix *a, const Matrix *b, const Matrix *c, const Matrix *d) {
+    return a->layout == LA_ROW_MAJOR && b->layout == LA_ROW_MAJOR &&
+           c->layout == LA_ROW_MAJOR && d->layout == LA_ROW_MAJOR;
+}
+
+typedef la_status (*tridiag_fn)(Matrix *, const Matrix *, const Matrix *, const Matrix *,
+                                const Matrix *, size_t nthreads);
+
+// Runs fn on row-major views of the four inputs, passing nthreads through
+static la_status with_row_major(tridiag_fn fn, Matrix *X_out, const Matrix *dl,
+                                const Matrix *d, const Matrix *du, const Matrix *B,
+                                size_t nthreads) {
+    Matrix t[4] = {{0}};
+    const Matrix *r[4] = {NULL};
+    const Matrix *in[4] = {dl, d, du, B};
+    la_status st = LA_OK;
+    for (int i = 0; i < 4 && st == LA_OK; i++) st = la_matrix_row_major(in[i], &t[i], &r[i]);
+    if (st == LA_OK) st = fn(X_out, r[0], r[1], r[2], r[3], nthreads);
+    for (int i = 0; i < 4; i++) la_matrix_free(&t[i]);
+    return st;
+}
+
+// la_tridiag_solve as a tridiag_fn; the single solve is serial
+static la_status tridiag_solve_fn(Matrix *X_out, const Matrix *dl, const Matrix *d,
+                                  const Matrix *du, const Matrix *B, size_t nthreads) {
+    (void)nthreads;
+    return la_tridiag_solve(X_out, dl, d, du, B);
+}
+
+la_status la_tridiag_solve(Matrix *X_out, const Matrix *dl, const Matrix *d,
+                           const Matrix *du, const Matrix *B) {
+    if (!X_out || !dl || !d || !du || !B) return LA_ERR_DIM;
+    if (!dl->data || !d->data || !du->data || !B->data) return LA_ERR_DIM;
+    if (X_out->data != NULL) return LA_ERR_DIM;
+
+    const size_t n = d->rows;
+    if (d->cols != 1 || dl->cols != 1 || du->cols != 1) return LA_ERR_DIM;
+    if (dl->rows != n || du->rows != n || B->rows != n) return LA_ERR_DIM;
+
+    if (!all_row_major(dl, d, du, B)) {
+        return with_row_major(tridiag_solve_fn, X_out, dl, d, du, B, 0);
+    }
+
+    double *cp = (double *)malloc(n * sizeof(double));
+    if (!cp) return LA_ERR_ALLOC;
+    LA_PROF_ALLOC(n * sizeof(double));
+
+    la_status st = la_matrix_init(X_out, n, B->cols);
+    if (st == LA_OK &&
+        !thomas(n, B->cols, dl->data, d->data, du->data, B->data, X_out->data, cp)) {
+        la_matrix_free(X_out);
+        st = LA_ERR_SINGULAR;
+    }
+    free(cp);
+    return st;
+}
+
+typedef struct {
+  const Matrix *DL, *D, *DU, *B;
+  Matrix *X;
+} batch_ctx;
+
+typedef struct {
+  const batch_ctx *c;
+  size_t r0, r1;  // systems [r0, r1)
+} batch_task;
+
+static la_status tridiag_batch_task(void *arg) {
+    const batch_task *t = (const batch_task *)arg;
+    const batch_ctx *c = t->c;
+    const size_t n = c->D->cols;
+
+    double *cp = (double *)malloc(n * sizeof(double));
+    if (!cp) return LA_ERR_ALLOC;
+
+    la_status st = LA_OK;
+    for (size_t r = t->r0; r < t->r1 && st == LA_OK; r++) {
+        const size_t off = r * n;
+        if (!thomas(n, 1, c->DL->data + off, c->D->data + off, c->DU->data + off,
+                    c->B->data + off, c->X->data + off, cp)) {
+            st = LA_ERR_SINGULAR;
+        }
+    }
+    free(cp);
+    return st;
+}
+
+la_status la_tridiag_solve_batch(Matrix *X_out, const Matrix *DL, const Matrix *D,
+                                 const Matrix *DU, const Matrix *B, size_t nthreads) {
+    if (!X_out || !DL || !D || !DU || !B) return LA_ERR_DIM;
+    if (!DL->data || !D->data || !DU->data || !B->data) return LA_ERR_DIM;
+    if (X_out->data != NULL) return LA_ERR_DIM;
+
+    const size_t m = D->rows;
+    const size_t n = D->cols;
+    if (DL->rows != m || DU->rows != m || B->rows != m) return LA_ERR_DIM;
+    if (DL->cols != n || DU->cols != n || B->cols != n) return LA_ERR_DIM;
+
+    if (!all_row_major(DL, D, DU, B)) {
+        return with_row_major(la_tridiag_solve_batch, X_out, DL, D, DU, B, nthreads);
+    }
+
+    la_status st = la_matrix_init(X_out, m, n);
+    if (st != LA_OK) return st;
+
+    // Systems are independent: contiguous chunks, no accesses, no edges
+    const size_t threads = la_task_threads(nthreads);
+    const size_t ntasks = min_size(m, threads * LA_BATCH_TASKS_PER_THREAD);
+    batch_ctx c = {DL, D, DU, B, X_out};
+
+    la_graph *g = la_graph_create(0, threads);
+    if (!g) st = LA_ERR_ALLOC;
+
+    for (size_t t = 0; t < ntasks && st == LA_OK; t++) {
+        batch_task bt = {&c, m * t / ntasks, m * (t + 1) / ntasks};
+        st = la_graph_submit(g, tridiag_batch_task, &bt, sizeof(bt), 0, NULL, 0);
+    }
+    if (st == LA_OK) st = la_graph_run(g);
+    la_graph_destroy(g);
+
+    if (st != LA_OK) la_matrix_free(X_out);
+    return st;
+}
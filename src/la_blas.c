@@ -0,0 +1,488 @@
+#include "la_blas.h"
+#include "la_blas_internal.h"
+#include "la_kernels.h"
+#include "la_matrix_internal.h"
+#include "la_task.h"
+
+#include <float.h>   // DBL_MIN, DBL_EPSILON
+#include <math.h>    // fabs, sqrt, isfinite
+#include <stdatomic.h>
+#include <stdlib.h>  // malloc, free
+
+// Edge of the diagonal blocks; the rows they feed are updated per block
+static const size_t LA_BLAS_NB = 64;
+
+// Fewest right-hand sides worth a task of their own
+static const size_t LA_BLAS_MIN_COLS = 32;
+
+// Below this many multiply-adds a call stays on the calling thread
+static const double LA_BLAS_PAR_WORK = 4e6;
+
+// Fewest matrix entries a gemv task should stream
+static const size_t LA_BLAS_TASK_ELEMS = (size_t)1 << 18;
+
+// Most ranges la_blas_parallel_for makes in deterministic mode
+static const size_t LA_BLAS_DET_CHUNKS = 64;
+
+static atomic_size_t g_threads = 0;
+static atomic_int g_deterministic = 0;
+
+// op(T)(i, j) = t[i * rs + j * cs]
+typedef struct {
+  const double *t;
+  size_t rs, cs;
+  int lower;  // op(T) is lower triangular
+  int unit;
+} tri;
+
+#define TRI(o, i, j) ((o)->t[(i) * (o)->rs + (j) * (o)->cs])
+
+static size_t min_size(size_t a, size_t b) {
+    return a < b ? a : b;
+}
+
+static void scale_row(size_t n, double a, double *x) {
+    for (size_t j = 0; j < n; j++) {
+        x[j] *= a;
+    }
+}
+
+static void divide_row(size_t n, double d, double *x) {
+    for (size_t j = 0; j < n; j++) {
+        x[j] /= d;
+    }
+}
+
+// ---------------- Shared helpers ----------------
+
+size_t la_blas_threads(void) {
+    return la_task_threads(atomic_load(&g_threads));
+}
+
+typedef struct {
+  la_range_fn fn;
+  void *ctx;
+  size_t begin, end;
+} range_task;
+
+static la_status range_task_fn(void *arg) {
+    const range_task *t = (const range_task *)arg;
+    return t->fn(t->ctx, t->begin, t->end);
+}
+
+la_status la_blas_parallel_for(size_t count, size_t min_chunk, la_range_fn fn, void *ctx) {
+    const size_t threads = la_blas_threads();
+    const size_t per = min_chunk ? min_chunk : 1;
+    const int det = la_get_deterministic();
+
+    // Deterministic mode cuts ranges from the problem size alone, so each
+    // kernel sees the same pieces whatever the thread count
+    const size_t nchunks = min_size(det ? LA_BLAS_DET_CHUNKS : threads, count / per);
+    if (nchunks < 2) return fn(ctx, 0, count);
+
+    if (threads < 2) {
+        la_status st = LA_OK;
+        for (size_t c = 0; c < nchunks && st == LA_OK; c++) {
+            st = fn(ctx, count * c / nchunks, count * (c + 1) / nchunks);
+        }
+        return st;
+    }
+
+    la_graph *g = la_graph_create(0, threads);
+    if (!g) return LA_ERR_ALLOC;
+
+    la_status st = LA_OK;
+    for (size_t c = 0; c < nchunks && st == LA_OK; c++) {
+        range_task t = {fn, ctx, count * c / nchunks, count * (c + 1) / nchunks};
+        st = la_graph_submit(g, range_task_fn, &t, sizeof(t), 0, NULL, 0);
+    }
+    if (st == LA_OK) st = la_graph_run(g);
+    la_graph_destroy(g);
+    return st;
+}
+
+size_t la_vec_len(const Matrix *m) {
+    if (!m || !m->data || m->layout == LA_TILED) return 0;
+    if (m->rows == 1 || m->cols == 1) return m->rows * m->cols;
+    return 0;
+}
+
+// ---------------- Vector and matrix-vector ----------------
+
+la_status la_dot(double *out, const Matrix *x, const Matrix *y) {
+    if (!out) return LA_ERR_DIM;
+    const size_t n = la_vec_len(x);
+    if (n == 0 || la_vec_len(y) != n) return LA_ERR_DIM;
+
+    *out = la_kern_dot(n, x->data, y->data);
+    return LA_OK;
+}
+
+la_status la_nrm2(double *out, const Matrix *x) {
+    if (!out) return LA_ERR_DIM;
+    const size_t n = la_vec_len(x);
+    if (n == 0) return LA_ERR_DIM;
+
+    // Fast path; rescale only if the plain sum of squares left the safe range
+    const double ssq = la_kern_dot(n, x->data, x->data);
+    if (isfinite(ssq) && ssq > DBL_MIN / DBL_EPSILON) {
+        *out = sqrt(ssq);
+        return LA_OK;
+    }
+
+    double scale = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        if (fabs(x->data[i]) > scale) scale = fabs(x->data[i]);
+    }
+    if (scale == 0.0 || !isfinite(scale)) {
+        *out = scale;
+        return LA_OK;
+    }
+
+    double sum = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        const double v = x->data[i] / scale;
+        sum += v * v;
+    }
+    *out = scale * sqrt(sum);
+    return LA_OK;
+}
+
+typedef struct {
+  const Matrix *A;
+  const double *x;
+  double *y;
+  double alpha, beta;
+} gemv_ctx;
+
+// y[i] for rows [begin, end): one contiguous dot product per row of A
+static la_status gemv_rows(void *arg, size_t begin, size_t end) {
+    const gemv_ctx *c = (const gemv_ctx *)arg;
+    const size_t n = c->A->cols;
+    for (size_t i = begin; i < end; i++) {
+        const double v = c->alpha * la_kern_dot(n, c->A->data + i * n, c->x);
+        c->y[i] = (c->beta == 0.0) ? v : v + c->beta * c->y[i];
+    }
+    return LA_OK;
+}
+
+// y[j] for columns [begin, end) of A: axpys along the rows of A
+static la_status gemv_cols(void *arg, size_t begin, size_t end) {
+    const gemv_ctx *c = (const gemv_ctx *)arg;
+    const size_t n = c->A->cols;
+    double *y = c->y + begin;
+
+    for (size_t j = 0; j < end - begin; j++) {
+        y[j] = (c->beta == 0.0) ? 0.0 : c->beta * y[j];
+    }
+    for (size_t i = 0; i < c->A->rows; i++) {
+        la_kern_axpy(end - begin, c->alpha * c->x[i], c->A->data + i * n + begin, y);
+    }
+    return LA_OK;
+}
+
+la_status la_gemv(la_trans trans, double alpha, const Matrix *A, const Matrix *x,
+                  double beta, Matrix *y) {
+    if (!A || !A->data) return LA_ERR_DIM;
+    const size_t xn = (trans == LA_TRANS) ? A->rows : A->cols;
+    const size_t yn = (trans == LA_TRANS) ? A->cols : A->rows;
+    if (la_vec_len(x) != xn || la_vec_len(y) != yn) return LA_ERR_DIM;
+
+    if (A->layout == LA_COL_MAJOR) {
+        // Stored as row-major A^T: apply the other transpose to the storage
+        const Matrix At = la_matrix_storage_view(A);
+        return la_gemv(trans == LA_TRANS ? LA_NO_TRANS : LA_TRANS, alpha, &At, x, beta, y);
+    }
+    if (A->layout == LA_TILED) {
+        Matrix tmp = (Matrix){0};
+        const Matrix *R = NULL;
+        la_status st = la_matrix_row_major(A, &tmp, &R);
+        if (st == LA_OK) st = la_gemv(trans, alpha, R, x, beta, y);
+        la_matrix_free(&tmp);
+        return st;
+    }
+
+    // Each y entry streams xn entries of A
+    gemv_ctx c = {A, x->data, y->data, alpha, beta};
+    const size_t min_chunk = LA_BLAS_TASK_ELEMS / xn + 1;
+    if (trans == LA_TRANS) {
+        return la_blas_parallel_for(yn, min_chunk, gemv_cols, &c);
+    }
+    return la_blas_parallel_for(yn, min_chunk, gemv_rows, &c);
+}
+
+// ---------------- Single right-hand side ----------------
+
+// x := op(T)^-1 x. Row-contiguous op(T) uses dot products along its rows,
+// column-contiguous op(T) uses axpys along its columns.
+static void trsv_core(const tri *o, size_t m, double *x) {
+    if (o->cs == 1) {
+        if (o->lower) {
+            for (size_t i = 0; i < m; i++) {
+                x[i] -= la_kern_dot(i, &TRI(o, i, 0), x);
+                if (!o->unit) x[i] /= TRI(o, i, i);
+            }
+        } else {
+            for (size_t i = m; i-- > 0;) {
+                x[i] -= la_kern_dot(m - i - 1, &TRI(o, i, i + 1), x + i + 1);
+                if (!o->unit) x[i] /= TRI(o, i, i);
+            }
+        }
+        return;
+    }
+
+    if (o->lower) {
+        for (size_t p = 0; p < m; p++) {
+            if (!o->unit) x[p] /= TRI(o, p, p);
+            la_kern_axpy(m - p - 1, -x[p], &TRI(o, p + 1, p), x + p + 1);
+        }
+    } else {
+        for (size_t p = m; p-- > 0;) {
+            if (!o->unit) x[p] /= TRI(o, p, p);
+            la_kern_axpy(p, -x[p], &TRI(o, 0, p), x);
+        }
+    }
+}
+
+// ---------------- Multiple right-hand sides ----------------
+
+// X := op(T)^-1 X for m x n X. Each diagonal block is solved row by row and
+// its rows are then applied to every row it feeds while still in cache.
+static void trsm_core(const tri *o, size_t m, size_t n, double *X, size_t ldx) {
+    const size_t nb = LA_BLAS_NB;
+
+    if (o->lower) {
+        for (size_t k0 = 0; k0 < m; k0 += nb) {
+            const size_t k1 = min_size(m, k0 + nb);
+            for (size_t i = k0; i < k1; i++) {
+                double *xi = X + i * ldx;
+                for (size_t p = k0; p < i; p++) {
+                    la_kern_axpy(n, -TRI(o, i, p), X + p * ldx, xi);
+                }
+                if (!o->unit) divide_row(n, TRI(o, i, i), xi);
+            }
+            for (size_t i = k1; i < m; i++) {
+                double *xi = X + i * ldx;
+                for (size_t p = k0; p < k1; p++) {
+                    la_kern_axpy(n, -TRI(o, i, p), X + p * ldx, xi);
+                }
+            }
+        }
+        return;
+    }
+
+    for (size_t k1 = m; k1 > 0;) {
+        const size_t k0 = (k1 > nb) ? k1 - nb : 0;
+        for (size_t i = k1; i-- > k0;) {
+            double *xi = X + i * ldx;
+            for (size_t p = i + 1; p < k1; p++) {
+                la_kern_axpy(n, -TRI(o, i, p), X + p * ldx, xi);
+            }
+            if (!o->unit) divide_row(n, TRI(o, i, i), xi);
+        }
+        for (size_t i = 0; i < k0; i++) {
+            double *xi = X + i * ldx;
+            for (size_t p = k0; p < k1; p++) {
+                la_kern_axpy(n, -TRI(o, i, p), X + p * ldx, xi);
+            }
+        }
+        k1 = k0;
+    }
+}
+
+// X := op(T) X. Upper: rows are produced top-down, each reading only rows at
+// or below itself that are still unmodified; lower is the mirror image.
+static void trmm_core(const tri *o, size_t m, size_t n, double *X, size_t ldx) {
+    const size_t nb = LA_BLAS_NB;
+
+    if (!o->lower) {
+        for (size_t k0 = 0; k0 < m; k0 += nb) {
+            const size_t k1 = min_size(m, k0 + nb);
+            for (size_t i = k0; i < k1; i++) {
+                double *xi = X + i * ldx;
+                if (!o->unit) scale_row(n, TRI(o, i, i), xi);
+                for (size_t p = i + 1; p < k1; p++) {
+                    la_kern_axpy(n, TRI(o, i, p), X + p * ldx, xi);
+                }
+            }
+            for (size_t i = k0; i < k1; i++) {
+                double *xi = X + i * ldx;
+                for (size_t p = k1; p < m; p++) {
+                    la_kern_axpy(n, TRI(o, i, p), X + p * ldx, xi);
+                }
+            }
+        }
+        return;
+    }
+
+    for (size_t k1 = m; k1 > 0;) {
+        const size_t k0 = (k1 > nb) ? k1 - nb : 0;
+        for (size_t i = k1; i-- > k0;) {
+            double *xi = X + i * ldx;
+            if (!o->unit) scale_row(n, TRI(o, i, i), xi);
+            for (size_t p = k0; p < i; p++) {
+                la_kern_axpy(n, TRI(o, i, p), X + p * ldx, xi);
+            }
+        }
+        for (size_t i = k0; i < k1; i++) {
+            double *xi = X + i * ldx;
+            for (size_t p = 0; p < k0; p++) {
+                la_kern_axpy(n, TRI(o, i, p), X + p * ldx, xi);
+            }
+        }
+        k1 = k0;
+    }
+}
+
+// ---------------- Threading ----------------
+
+typedef struct {
+  const tri *o;
+  int solve;
+  size_t m, n;
+  double *X;
+  size_t ldx;
+} tri_task;
+
+static void tri_run(const tri_task *t) {
+    if (t->solve && t->n == 1 && t->ldx == 1) {
+        trsv_core(t->o, t->m, t->X);
+    } else if (t->solve) {
+        trsm_core(t->o, t->m, t->n, t->X, t->ldx);
+    } else {
+        trmm_core(t->o, t->m, t->n, t->X, t->ldx);
+    }
+}
+
+// Columns [begin, end) of the right-hand sides
+static la_status tri_cols(void *arg, size_t begin, size_t end) {
+    const tri_task *w = (const tri_task *)arg;
+    const tri_task t = {w->o, w->solve, w->m, end - begin, w->X + begin, w->ldx};
+    tri_run(&t);
+    return LA_OK;
+}
+
+// Columns of X are independent right-hand sides: split them across threads
+static la_status tri_left(const tri *o, int solve, size_t m, size_t n, double *X, size_t ldx) {
+    tri_task whole = {o, solve, m, n, X, ldx};
+    if ((double)m * (double)m * (double)n < LA_BLAS_PAR_WORK) {
+        tri_run(&whole);
+        return LA_OK;
+    }
+    return la_blas_parallel_for(n, LA_BLAS_MIN_COLS, tri_cols, &whole);
+}
+
+static void transpose_into(double *dst, const double *src, size_t rows, size_t cols) {
+    for (size_t i = 0; i < rows; i++) {
+        for (size_t j = 0; j < cols; j++) {
+            dst[j * rows + i] = src[i * cols + j];
+        }
+    }
+}
+
+// Tiled operands go through row-major copies; B is stored back afterwards.
+static la_status tri_apply(int solve, la_side side, la_uplo uplo, la_trans trans,
+                           la_diag diag, double alpha, const Matrix *T, Matrix *B);
+
+static la_status tri_apply_tiled(int solve, la_side side, la_uplo uplo, la_trans trans,
+                                 la_diag diag, double alpha, const Matrix *T, Matrix *B) {
+    Matrix tt = (Matrix){0}, tb = (Matrix){0};
+    const Matrix *rt = NULL;
+    Matrix *rb = NULL;
+    la_status st = la_matrix_row_major(T, &tt, &rt);
+    if (st == LA_OK) st = la_matrix_row_major_inout(B, &tb, &rb);
+    if (st == LA_OK) st = tri_apply(solve, side, uplo, trans, diag, alpha, rt, rb);
+    la_matrix_free(&tt);
+    la_matrix_commit(B, &tb);
+    return st;
+}
+
+static la_status tri_apply(int solve, la_side side, la_uplo uplo, la_trans trans,
+                           la_diag diag, double alpha, const Matrix *T, Matrix *B) {
+    if (!T || !B || !T->data || !B->data) return LA_ERR_DIM;
+    if (T->rows != T->cols) return LA_ERR_DIM;
+    if (T->rows != (side == LA_LEFT ? B->rows : B->cols)) return LA_ERR_DIM;
+    if (T->layout == LA_TILED || B->layout == LA_TILED) {
+        return tri_apply_tiled(solve, side, uplo, trans, diag, alpha, T, B);
+    }
+
+    const size_t rows = B->rows;
+    const size_t cols = B->cols;
+
+    if (alpha == 0.0) {
+        la_matrix_fill(B, 0.0);
+        return LA_OK;
+    }
+    if (alpha != 1.0) {
+        scale_row(rows * cols, alpha, B->data);
+    }
+
+    tri o = {T->data, T->cols, 1, uplo == LA_LOWER, diag == LA_UNIT};
+    if (T->layout == LA_COL_MAJOR) {
+        o.rs = 1;
+        o.cs = T->rows;
+    }
+    if (trans == LA_TRANS) {
+        const size_t tmp = o.rs;
+        o.rs = o.cs;
+        o.cs = tmp;
+        o.lower = !o.lower;
+    }
+
+    // B op(T) = (op(T)^T B^T)^T: the right side is a left solve on B^T
+    const int flip = (side == LA_RIGHT);
+    if (flip) {
+        const size_t tmp = o.rs;
+        o.rs = o.cs;
+        o.cs = tmp;
+        o.lower = !o.lower;
+    }
+    const size_t m = flip ? cols : rows;
+    const size_t n = flip ? rows : cols;
+
+    // B's storage is row-major B, or B^T when B is column-major (the two
+    // coincide for vectors)
+    const int stored_t = (B->layout == LA_COL_MAJOR && rows > 1 && cols > 1);
+    if (flip == stored_t) {
+        return tri_left(&o, solve, m, n, B->data, n);
+    }
+
+    // Otherwise work on a transposed copy
+    double *X = (double *)malloc(rows * cols * sizeof(double));
+    if (!X) return LA_ERR_ALLOC;
+    transpose_into(X, B->data, n, m);
+
+    la_status st = tri_left(&o, solve, m, n, X, n);
+    if (st == LA_OK) transpose_into(B->data, X, m, n);
+    free(X);
+    return st;
+}
+
+// ---------------- Public API ----------------
+
+la_status la_trsm(la_side side, la_uplo uplo, la_trans trans, la_diag diag,
+                  double alpha, const Matrix *T, Matrix *B) {
+    return tri_apply(1, side, uplo, trans, diag, alpha, T, B);
+}
+
+la_status la_trmm(la_side side, la_uplo uplo, la_trans trans, la_diag diag,
+                  double alpha, const Matrix *T, Matrix *B) {
+    return tri_apply(0, side, uplo, trans, diag, alpha, T, B);
+}
+
+la_status la_trsv(la_uplo uplo, la_trans trans, la_diag diag, const Matrix *T, Matrix *x) {
+    if (!x || x->cols != 1 || x->layout == LA_TILED) return LA_ERR_DIM;
+    return tri_apply(1, LA_LEFT, uplo, trans, diag, 1.0, T, x);
+}
+
+void la_blas_set_threads(size_t nthreads) {
+    atomic_store(&g_threads, nthreads);
+}
+
+void la_set_deterministic(int on) {
+    atomic_store(&g_deterministic, on != 0);
+}
+
+int la_get_deterministic(void) {
+    return atomic_load(&g_deterministic);
+}
@@ -0,0 +1,21 @@
+#ifndef LA_BLAS_INTERNAL_H
+#define LA_BLAS_INTERNAL_H
+
+#include "la_blas.h"
+
+// Range body for la_blas_parallel_for: handles items [begin, end).
+typedef la_status (*la_range_fn)(void *ctx, size_t begin, size_t end);
+
+// Threads set by la_blas_set_threads, resolved (0 -> online CPUs).
+size_t la_blas_threads(void);
+
+// Splits [0, count) into contiguous ranges of at least min_chunk items, one
+// per thread, and runs fn on each. Runs fn(ctx, 0, count) on the calling
+// thread when there is not enough work for two ranges. In deterministic
+// mode the ranges depend on count and min_chunk only.
+la_status la_blas_parallel_for(size_t count, size_t min_chunk, la_range_fn fn, void *ctx);
+
+// Number of entries if m is a row or column vector, 0 otherwise.
+size_t la_vec_len(const Matrix *m);
+
+#endif
@@ -0,0 +1,358 @@
+#include "la_cache.h"
+#include "la_matrix_internal.h"
+#include "la_prof_internal.h"
+#include "la_solve_internal.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CACHE_MIN_BUCKETS 64
+
+typedef struct entry {
+  uint64_t hash;
+  Matrix A;           // copy of the key, compared on lookup
+  la_lu f;
+  la_status status;   // LA_ERR_SINGULAR: negative entry, f is empty
+  size_t bytes;
+  int refs;           // callers currently solving with f
+  int linked;         // still in the table (0 once evicted while in use)
+  struct entry *hnext;
+  struct entry *prev, *next;  // LRU list, most recent first
+} entry;
+
+struct la_factor_cache {
+  pthread_mutex_t lock;
+  entry **buckets;
+  size_t nbuckets;    // power of two
+  entry *head, *tail;
+  size_t entries;
+  size_t bytes;
+  size_t max_bytes;
+  unsigned long long hits;
+  unsigned long long misses;
+  unsigned long long evictions;
+};
+
+static _Atomic(la_factor_cache *) g_cache = NULL;
+
+// ---------------- Hashing ----------------
+
+static uint64_t rotl(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static uint64_t mix(uint64_t h, uint64_t v) {
+    h ^= v * 0x9E3779B97F4A7C15ull;
+    return rotl(h, 31) * 0xC2B2AE3D27D4EB4Full;
+}
+
+// Four independent lanes over the raw 64-bit words, so the multiplies
+// pipeline; roughly memory speed for large matrices.
+static uint64_t matrix_hash(const Matrix *A) {
+    const size_t count = A->rows * A->cols;
+    const double *d = A->data;
+    uint64_t h[4] = {0x243F6A8885A308D3ull, 0x13198A2E03707344ull,
+                     0xA4093822299F31D0ull, 0x082EFA98EC4E6C89ull};
+    uint64_t w[4];
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        memcpy(w, d + i, sizeof(w));
+        h[0] = mix(h[0], w[0]);
+        h[1] = mix(h[1], w[1]);
+        h[2] = mix(h[2], w[2]);
+        h[3] = mix(h[3], w[3]);
+    }
+    for (; i < count; i++) {
+        memcpy(w, d + i, sizeof(w[0]));
+        h[0] = mix(h[0], w[0]);
+    }
+
+    uint64_t r = rotl(h[0], 1) + rotl(h[1], 7) + rotl(h[2], 12) + rotl(h[3], 18);
+    r = mix(r, (uint64_t)A->rows);
+    r = mix(r, (uint64_t)A->cols);
+    r ^= r >> 33;
+    r *= 0xFF51AFD7ED558CCDull;
+    r ^= r >> 33;
+    return r;
+}
+
+// ---------------- Entries ----------------
+
+static void entry_free(entry *e) {
+    la_matrix_free(&e->A);
+    la_lu_free(&e->f);
+    free(e);
+}
+
+static int same_key(const entry *e, uint64_t hash, const Matrix *A) {
+    return e->hash == hash && e->A.rows == A->rows && e->A.cols == A->cols &&
+           memcmp(e->A.data, A->data, A->rows * A->cols * sizeof(double)) == 0;
+}
+
+static entry *table_find(la_factor_cache *c, uint64_t hash, const Matrix *A) {
+    for (entry *e = c->buckets[hash & (c->nbuckets - 1)]; e; e = e->hnext) {
+        if (same_key(e, hash, A)) return e;
+    }
+    return NULL;
+}
+
+static void lru_unlink(la_factor_cache *c, entry *e) {
+    if (e->prev) e->prev->next = e->next; else c->head = e->next;
+    if (e->next) e->next->prev = e->prev; else c->tail = e->prev;
+    e->prev = e->next = NULL;
+}
+
+static void lru_push_front(la_factor_cache *c, entry *e) {
+    e->prev = NULL;
+    e->next = c->head;
+    if (c->head) c->head->prev = e; else c->tail = e;
+    c->head = e;
+}
+
+// Removes e from the table; frees it unless a caller still holds it
+static void table_remove(la_factor_cache *c, entry *e) {
+    entry **pp = &c->buckets[e->hash & (c->nbuckets - 1)];
+    while (*pp != e) pp = &(*pp)->hnext;
+    *pp = e->hnext;
+    lru_unlink(c, e);
+
+    c->entries--;
+    c->bytes -= e->bytes;
+    e->linked = 0;
+    if (e->refs == 0) entry_free(e);
+}
+
+// Doubles the bucket array once entries outnumber buckets. Failure to grow
+// only makes chains longer.
+static void table_grow(la_factor_cache *c) {
+    const size_t nb = c->nbuckets * 2;
+    entry **b = (entry **)calloc(nb, sizeof(entry *));
+    if (!b) return;
+
+    for (size_t i = 0; i < c->nbuckets; i++) {
+        entry *e = c->buckets[i];
+        while (e) {
+            entry *next = e->hnext;
+            e->hnext = b[e->hash & (nb - 1)];
+            b[e->hash & (nb - 1)] = e;
+            e = next;
+        }
+    }
+    free(c->buckets);
+    c->buckets = b;
+    c->nbuckets = nb;
+}
+
+// Evicts least recently used idle entries until e fits, then links it.
+// Returns 0 (leaving e unlinked) if it cannot fit under max_bytes.
+static int table_insert(la_factor_cache *c, entry *e) {
+    if (e->bytes > c->max_bytes) return 0;
+
+    entry *victim = c->tail;
+    while (c->bytes + e->bytes > c->max_bytes && victim) {
+        entry *prev = victim->prev;
+        if (victim->refs == 0) {
+            table_remove(c, victim);
+            c->evictions++;
+        }
+        victim = prev;
+    }
+    if (c->bytes + e->bytes > c->max_bytes) return 0;
+
+    if (c->entries >= c->nbuckets) table_grow(c);
+    entry **bucket = &c->buckets[e->hash & (c->nbuckets - 1)];
+    e->hnext = *bucket;
+    *bucket = e;
+    lru_push_front(c, e);
+    e->linked = 1;
+    c->entries++;
+    c->bytes += e->bytes;
+    return 1;
+}
+
+// Returns a held entry with the factors of A, factoring on a miss. Entries
+// that do not fit in the cache are handed out unlinked and freed on release.
+static la_status cache_acquire(la_factor_cache *c, const Matrix *A, entry **out) {
+    if (A->layout != LA_ROW_MAJOR) {
+        // Keys are row-major contents, so equal matrices match across layouts
+        Matrix tmp = (Matrix){0};
+        const Matrix *R = NULL;
+        la_status st = la_matrix_row_major(A, &tmp, &R);
+        if (st == LA_OK) st = cache_acquire(c, R, out);
+        la_matrix_free(&tmp);
+        return st;
+    }
+
+    const uint64_t hash = matrix_hash(A);
+
+    pthread_mutex_lock(&c->lock);
+    entry *e = table_find(c, hash, A);
+    if (e) {
+        c->hits++;
+        lru_unlink(c, e);
+        lru_push_front(c, e);
+        const la_status est = e->status;
+        if (est == LA_OK) e->refs++;
+        pthread_mutex_unlock(&c->lock);
+        if (est != LA_OK) return est;
+        *out = e;
+        return LA_OK;
+    }
+    c->misses++;
+    pthread_mutex_unlock(&c->lock);
+
+    e = (entry *)calloc(1, sizeof(entry));
+    if (!e) return LA_ERR_ALLOC;
+    LA_PROF_ALLOC(sizeof(entry));
+
+    // Singular matrices are remembered too, so repeats skip the elimination
+    const la_status fst = la_solve_factor(&e->f, A);
+    la_status st = (fst == LA_OK || fst == LA_ERR_SINGULAR) ? la_matrix_copy(&e->A, A) : fst;
+    if (st != LA_OK) {
+        entry_free(e);
+        return st;
+    }
+    e->status = fst;
+    e->hash = hash;
+    e->refs = (fst == LA_OK);
+    e->bytes = sizeof(entry) + A->rows * A->cols * sizeof(double);
+    if (fst == LA_OK) e->bytes += A->rows * A->cols * sizeof(double) + A->rows * sizeof(size_t);
+
+    pthread_mutex_lock(&c->lock);
+    entry *other = table_find(c, hash, A);
+    if (other) {
+        // Another thread factored the same matrix meanwhile
+        const la_status ost = other->status;
+        if (ost == LA_OK) other->refs++;
+        pthread_mutex_unlock(&c->lock);
+        entry_free(e);
+        if (ost != LA_OK) return ost;
+        *out = other;
+        return LA_OK;
+    }
+    const int linked = table_insert(c, e);
+    pthread_mutex_unlock(&c->lock);
+
+    if (fst != LA_OK) {
+        if (!linked) entry_free(e);
+        return fst;
+    }
+    *out = e;
+    return LA_OK;
+}
+
+static void cache_release(la_factor_cache *c, entry *e) {
+    pthread_mutex_lock(&c->lock);
+    e->refs--;
+    const int dead = (e->refs == 0 && !e->linked);
+    pthread_mutex_unlock(&c->lock);
+    if (dead) entry_free(e);
+}
+
+// ---------------- Public API ----------------
+
+la_status la_cache_create(la_factor_cache **out, size_t max_bytes) {
+    if (!out) return LA_ERR_DIM;
+    *out = NULL;
+
+    la_factor_cache *c = (la_factor_cache *)calloc(1, sizeof(la_factor_cache));
+    if (!c) return LA_ERR_ALLOC;
+    c->buckets = (entry **)calloc(CACHE_MIN_BUCKETS, sizeof(entry *));
+    if (!c->buckets) {
+        free(c);
+        return LA_ERR_ALLOC;
+    }
+    c->nbuckets = CACHE_MIN_BUCKETS;
+    c->max_bytes = max_bytes;
+    pthread_mutex_init(&c->lock, NULL);
+
+    *out = c;
+    return LA_OK;
+}
+
+void la_cache_destroy(la_factor_cache *c) {
+    if (!c) return;
+    entry *e = c->head;
+    while (e) {
+        entry *next = e->next;
+        entry_free(e);
+        e = next;
+    }
+    pthread_mutex_destroy(&c->lock);
+    free(c->buckets);
+    free(c);
+}
+
+void la_cache_clear(la_factor_cache *c) {
+    if (!c) return;
+    pthread_mutex_lock(&c->lock);
+    entry *e = c->head;
+    while (e) {
+        entry *next = e->next;
+        if (e->refs == 0) table_remove(c, e);
+        e = next;
+    }
+    pthread_mutex_unlock(&c->lock);
+}
+
+la_status la_cache_get_stats(la_factor_cache *c, la_cache_stats *out) {
+    if (!c || !out) return LA_ERR_DIM;
+    pthread_mutex_lock(&c->lock);
+    out->hits = c->hits;
+    out->misses = c->misses;
+    out->evictions = c->evictions;
+    out->entries = c->entries;
+    out->bytes = c->bytes;
+    out->max_bytes = c->max_bytes;
+    pthread_mutex_unlock(&c->lock);
+    return LA_OK;
+}
+
+la_status la_cache_solve(la_factor_cache *c, Matrix *X_out, const Matrix *A,
+                         const Matrix *B) {
+    if (!c || !X_out || !A || !B || !A->data || !B->data) return LA_ERR_DIM;
+    if (X_out->data != NULL) return LA_ERR_DIM;
+    if (A->rows != A->cols || B->rows != A->rows) return LA_ERR_DIM;
+
+    entry *e = NULL;
+    la_status st = cache_acquire(c, A, &e);
+    if (st != LA_OK) return st;
+
+    st = la_lu_solve(X_out, &e->f, B);
+    cache_release(c, e);
+    return st;
+}
+
+la_status la_cache_det(la_factor_cache *c, double *det_out, const Matrix *A) {
+    if (!c || !det_out || !A || !A->data) return LA_ERR_DIM;
+    if (A->rows != A->cols) return LA_ERR_DIM;
+
+    entry *e = NULL;
+    la_status st = cache_acquire(c, A, &e);
+    if (st == LA_ERR_SINGULAR) {
+        *det_out = 0.0;
+        return LA_ERR_SINGULAR;
+    }
+    if (st != LA_OK) return st;
+
+    double det = (double)e->f.sign;
+    for (size_t i = 0; i < e->f.LU.rows; i++) {
+        det *= LA_AT(&e->f.LU, i, i);
+    }
+    cache_release(c, e);
+
+    *det_out = det;
+    return LA_OK;
+}
+
+void la_set_factor_cache(la_factor_cache *c) {
+    atomic_store(&g_cache, c);
+}
+
+la_factor_cache *la_get_factor_cache(void) {
+    return atomic_load(&g_cache);
+}
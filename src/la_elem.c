@@ -0,0 +1,268 @@
+#include "la_elem.h"
+#include "la_blas_internal.h"
+#include "la_kernels.h"
+#include "la_matrix_internal.h"
+
+// Fewest entries an elementwise task should touch; these loops are memory
+// bound, so smaller pieces do not pay for the thread start-up.
+static const size_t LA_ELEM_TASK_ELEMS = (size_t)1 << 18;
+
+// ---------------- Row kernels ----------------
+
+static void op_vec(la_elem_op op, size_t n, const double *restrict a,
+                   const double *restrict b, double *restrict out) {
+    switch (op) {
+    case LA_ELEM_ADD:
+        for (size_t j = 0; j < n; j++) out[j] = a[j] + b[j];
+        break;
+    case LA_ELEM_SUB:
+        for (size_t j = 0; j < n; j++) out[j] = a[j] - b[j];
+        break;
+    case LA_ELEM_MUL:
+        for (size_t j = 0; j < n; j++) out[j] = a[j] * b[j];
+        break;
+    case LA_ELEM_DIV:
+        for (size_t j = 0; j < n; j++) out[j] = a[j] / b[j];
+        break;
+    }
+}
+
+static void op_scalar(la_elem_op op, size_t n, const double *restrict a, double s,
+                      double *restrict out) {
+    switch (op) {
+    case LA_ELEM_ADD:
+        for (size_t j = 0; j < n; j++) out[j] = a[j] + s;
+        break;
+    case LA_ELEM_SUB:
+        for (size_t j = 0; j < n; j++) out[j] = a[j] - s;
+        break;
+    case LA_ELEM_MUL:
+        for (size_t j = 0; j < n; j++) out[j] = a[j] * s;
+        break;
+    case LA_ELEM_DIV:
+        for (size_t j = 0; j < n; j++) out[j] = a[j] / s;
+        break;
+    }
+}
+
+// ---------------- Range bodies ----------------
+
+typedef struct {
+  const Matrix *a;
+  const Matrix *b;   // second operand, broadcast vector, or kron's b
+  Matrix *out;
+  la_elem_op op;
+  double alpha;
+} elem_ctx;
+
+// Rows [begin, end) of out = a op b, with b the same shape as a
+static la_status rows_binary(void *arg, size_t begin, size_t end) {
+    const elem_ctx *c = (const elem_ctx *)arg;
+    const size_t n = c->a->cols;
+    op_vec(c->op, (end - begin) * n, c->a->data + begin * n, c->b->data + begin * n,
+           c->out->data + begin * n);
+    return LA_OK;
+}
+
+static la_status rows_scale(void *arg, size_t begin, size_t end) {
+    const elem_ctx *c = (const elem_ctx *)arg;
+    const size_t n = c->a->cols;
+    op_scalar(LA_ELEM_MUL, (end - begin) * n, c->a->data + begin * n, c->alpha,
+              c->out->data + begin * n);
+    return LA_OK;
+}
+
+// out is y here and a is x
+static la_status rows_axpy(void *arg, size_t begin, size_t end) {
+    const elem_ctx *c = (const elem_ctx *)arg;
+    const size_t n = c->a->cols;
+    la_kern_axpy((end - begin) * n, c->alpha, c->a->data + begin * n,
+                 c->out->data + begin * n);
+    return LA_OK;
+}
+
+static la_status rows_bcast_row(void *arg, size_t begin, size_t end) {
+    const elem_ctx *c = (const elem_ctx *)arg;
+    const size_t n = c->a->cols;
+    for (size_t i = begin; i < end; i++) {
+        op_vec(c->op, n, c->a->data + i * n, c->b->data, c->out->data + i * n);
+    }
+    return LA_OK;
+}
+
+static la_status rows_bcast_col(void *arg, size_t begin, size_t end) {
+    const elem_ctx *c = (const elem_ctx *)arg;
+    const size_t n = c->a->cols;
+    for (size_t i = begin; i < end; i++) {
+        op_scalar(c->op, n, c->a->data + i * n, c->b->data[i], c->out->data + i * n);
+    }
+    return LA_OK;
+}
+
+// Output rows [begin, end): row i * b.rows + k is a(i, :) (x) b(k, :)
+static la_status rows_kron(void *arg, size_t begin, size_t end) {
+    const elem_ctx *c = (const elem_ctx *)arg;
+    const Matrix *a = c->a;
+    const Matrix *b = c->b;
+
+    for (size_t r = begin; r < end; r++) {
+        const double *arow = a->data + (r / b->rows) * a->cols;
+        const double *brow = b->data + (r % b->rows) * b->cols;
+        double *o = c->out->data + r * c->out->cols;
+        for (size_t j = 0; j < a->cols; j++) {
+            op_scalar(LA_ELEM_MUL, b->cols, brow, arow[j], o + j * b->cols);
+        }
+    }
+    return LA_OK;
+}
+
+// Allocates out like shape and runs body over its rows
+static la_status run_rows(Matrix *out, size_t rows, size_t cols, la_range_fn body,
+                          elem_ctx *c) {
+    la_status st = la_matrix_init(out, rows, cols);
+    if (st != LA_OK) return st;
+
+    c->out = out;
+    st = la_blas_parallel_for(rows, LA_ELEM_TASK_ELEMS / cols + 1, body, c);
+    if (st != LA_OK) la_matrix_free(out);
+    return st;
+}
+
+// Row-major or column-major: entrywise ops can run straight over the storage
+static int dense_layout(const Matrix *m) {
+    return m->layout == LA_ROW_MAJOR || m->layout == LA_COL_MAJOR;
+}
+
+// out = entrywise body(a[, b]). Operands that share a dense layout are
+// processed through their storage and out keeps the layout; anything else
+// goes through row-major copies and gives a row-major out.
+static la_status run_entrywise(Matrix *out, const Matrix *a, const Matrix *b,
+                               la_range_fn body, elem_ctx *c) {
+    if (dense_layout(a) && (!b || b->layout == a->layout)) {
+        const Matrix sa = la_matrix_storage_view(a);
+        const Matrix sb = b ? la_matrix_storage_view(b) : (Matrix){0};
+        c->a = &sa;
+        c->b = b ? &sb : NULL;
+
+        la_status st = run_rows(out, sa.rows, sa.cols, body, c);
+        if (st == LA_OK) {
+            out->rows = a->rows;
+            out->cols = a->cols;
+            out->layout = a->layout;
+        }
+        return st;
+    }
+
+    Matrix ta = (Matrix){0}, tb = (Matrix){0};
+    const Matrix *ra = NULL, *rb = NULL;
+    la_status st = la_matrix_row_major(a, &ta, &ra);
+    if (st == LA_OK && b) st = la_matrix_row_major(b, &tb, &rb);
+    if (st == LA_OK) {
+        c->a = ra;
+        c->b = rb;
+        st = run_rows(out, a->rows, a->cols, body, c);
+    }
+    la_matrix_free(&ta);
+    la_matrix_free(&tb);
+    return st;
+}
+
+// Row-major copies of a and its broadcast / kron operand v, then run_rows
+static la_status run_row_major(Matrix *out, const Matrix *a, const Matrix *v, size_t rows,
+                               size_t cols, la_range_fn body, elem_ctx *c) {
+    Matrix ta = (Matrix){0}, tv = (Matrix){0};
+    const Matrix *ra = NULL, *rv = NULL;
+    la_status st = la_matrix_row_major(a, &ta, &ra);
+    if (st == LA_OK) st = la_matrix_row_major(v, &tv, &rv);
+    if (st == LA_OK) {
+        c->a = ra;
+        c->b = rv;
+        st = run_rows(out, rows, cols, body, c);
+    }
+    la_matrix_free(&ta);
+    la_matrix_free(&tv);
+    return st;
+}
+
+static int valid_pair(const Matrix *out, const Matrix *a, const Matrix *b) {
+    if (!out || !a || !b || !a->data || !b->data) return 0;
+    if (out->data != NULL) return 0;
+    return a->rows == b->rows && a->cols == b->cols;
+}
+
+// ---------------- Public API ----------------
+
+la_status la_scale(Matrix *out, double alpha, const Matrix *a) {
+    if (!out || !a || !a->data) return LA_ERR_DIM;
+    if (out->data != NULL) return LA_ERR_DIM;
+
+    elem_ctx c = {a, NULL, NULL, LA_ELEM_MUL, alpha};
+    return run_entrywise(out, a, NULL, rows_scale, &c);
+}
+
+la_status la_axpy(Matrix *y, double alpha, const Matrix *x) {
+    if (!y || !x || !y->data || !x->data) return LA_ERR_DIM;
+    if (x->rows != y->rows || x->cols != y->cols) return LA_ERR_DIM;
+
+    if (dense_layout(y) && x->layout == y->layout) {
+        const Matrix sx = la_matrix_storage_view(x);
+        Matrix sy = la_matrix_storage_view(y);
+        elem_ctx c = {&sx, NULL, &sy, LA_ELEM_ADD, alpha};
+        return la_blas_parallel_for(sy.rows, LA_ELEM_TASK_ELEMS / sy.cols + 1, rows_axpy, &c);
+    }
+
+    Matrix tx = (Matrix){0}, ty = (Matrix){0};
+    const Matrix *rx = NULL;
+    Matrix *ry = NULL;
+    la_status st = la_matrix_row_major(x, &tx, &rx);
+    if (st == LA_OK) st = la_matrix_row_major_inout(y, &ty, &ry);
+    if (st == LA_OK) {
+        elem_ctx c = {rx, NULL, ry, LA_ELEM_ADD, alpha};
+        st = la_blas_parallel_for(ry->rows, LA_ELEM_TASK_ELEMS / ry->cols + 1, rows_axpy, &c);
+    }
+    la_matrix_free(&tx);
+    la_matrix_commit(y, &ty);
+    return st;
+}
+
+la_status la_hadamard(Matrix *out, const Matrix *a, const Matrix *b) {
+    if (!valid_pair(out, a, b)) return LA_ERR_DIM;
+
+    elem_ctx c = {a, b, NULL, LA_ELEM_MUL, 1.0};
+    return run_entrywise(out, a, b, rows_binary, &c);
+}
+
+la_status la_divide(Matrix *out, const Matrix *a, const Matrix *b) {
+    if (!valid_pair(out, a, b)) return LA_ERR_DIM;
+
+    elem_ctx c = {a, b, NULL, LA_ELEM_DIV, 1.0};
+    return run_entrywise(out, a, b, rows_binary, &c);
+}
+
+la_status la_bcast_row(Matrix *out, const Matrix *a, const Matrix *row, la_elem_op op) {
+    if (!out || !a || !row || !a->data || !row->data) return LA_ERR_DIM;
+    if (out->data != NULL) return LA_ERR_DIM;
+    if (row->rows != 1 || row->cols != a->cols) return LA_ERR_DIM;
+    if ((int)op < 0 || op > LA_ELEM_DIV) return LA_ERR_DIM;
+
+    elem_ctx c = {a, row, NULL, op, 1.0};
+    return run_row_major(out, a, row, a->rows, a->cols, rows_bcast_row, &c);
+}
+
+la_status la_bcast_col(Matrix *out, const Matrix *a, const Matrix *col, la_elem_op op) {
+    if (!out || !a || !col || !a->data || !col->data) return LA_ERR_DIM;
+    if (out->data != NULL) return LA_ERR_DIM;
+    if (col->cols != 1 || col->rows != a->rows) return LA_ERR_DIM;
+    if ((int)op < 0 || op > LA_ELEM_DIV) return LA_ERR_DIM;
+
+    elem_ctx c = {a, col, NULL, op, 1.0};
+    return run_row_major(out, a, col, a->rows, a->cols, rows_bcast_col, &c);
+}
+
+la_status la_kron(Matrix *out, const Matrix *a, const Matrix *b) {
+    if (!out || !a || !b || !a->data || !b->data) return LA_ERR_DIM;
+    if (out->data != NULL) return LA_ERR_DIM;
+
+    elem_ctx c = {a, b, NULL, LA_ELEM_MUL, 1.0};
+    return run_row_major(out, a, b, a->rows * b->rows, a->cols * b->cols, rows_kron, &c);
+}
@@ -0,0 +1,294 @@
+#include "la_kernels.h"
+#include "la_blas.h"  // la_get_deterministic
+#include <math.h>  // fabs, sqrt
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define LA_KERN_AVX2 1
+
+// a * b + c. Deterministic mode rounds the product on its own, as the
+// portable loops do (libla is built with -ffp-contract=off), so the vector
+// paths give the same bits as a build without AVX2.
+static inline __m256d madd(__m256d a, __m256d b, __m256d c, int fused) {
+    return fused ? _mm256_fmadd_pd(a, b, c) : _mm256_add_pd(_mm256_mul_pd(a, b), c);
+}
+#endif
+
+void la_kern_axpy(size_t n, double a, const double *x, double *y) {
+    size_t j = 0;
+#ifdef LA_KERN_AVX2
+    const int fused = !la_get_deterministic();
+    const __m256d va = _mm256_set1_pd(a);
+    for (; j + 8 <= n; j += 8) {
+        __m256d y0 = _mm256_loadu_pd(y + j);
+        __m256d y1 = _mm256_loadu_pd(y + j + 4);
+        y0 = madd(va, _mm256_loadu_pd(x + j), y0, fused);
+        y1 = madd(va, _mm256_loadu_pd(x + j + 4), y1, fused);
+        _mm256_storeu_pd(y + j, y0);
+        _mm256_storeu_pd(y + j + 4, y1);
+    }
+#endif
+    for (; j < n; j++) {
+        y[j] += a * x[j];
+    }
+}
+
+double la_kern_dot(size_t n, const double *x, const double *y) {
+    size_t j = 0;
+#ifdef LA_KERN_AVX2
+    const int fused = !la_get_deterministic();
+    __m256d acc = _mm256_setzero_pd();
+    for (; j + 4 <= n; j += 4) {
+        acc = madd(_mm256_loadu_pd(x + j), _mm256_loadu_pd(y + j), acc, fused);
+    }
+    double s[4];
+    _mm256_storeu_pd(s, acc);
+#else
+    double s[4] = {0.0, 0.0, 0.0, 0.0};
+    for (; j + 4 <= n; j += 4) {
+        s[0] += x[j] * y[j];
+        s[1] += x[j + 1] * y[j + 1];
+        s[2] += x[j + 2] * y[j + 2];
+        s[3] += x[j + 3] * y[j + 3];
+    }
+#endif
+    double sum = (s[0] + s[2]) + (s[1] + s[3]);
+    for (; j < n; j++) {
+        sum += x[j] * y[j];
+    }
+    return sum;
+}
+
+// One block of at most LA_KERN_STATS_BLOCK entries, in four lanes
+static void stats_block(size_t n, const double *x, la_kern_rstats *b) {
+    size_t j = 0;
+#ifdef LA_KERN_AVX2
+    const int fused = !la_get_deterministic();
+    const __m256d absmask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFll));
+    __m256d s = _mm256_setzero_pd(), a = s, q = s, m = s;
+    __m256d lo = _mm256_set1_pd(x[0]), hi = lo;
+    for (; j + 4 <= n; j += 4) {
+        const __m256d v = _mm256_loadu_pd(x + j);
+        const __m256d av = _mm256_and_pd(v, absmask);
+        s = _mm256_add_pd(s, v);
+        a = _mm256_add_pd(a, av);
+        q = madd(v, v, q, fused);
+        m = _mm256_max_pd(m, av);
+        lo = _mm256_min_pd(lo, v);
+        hi = _mm256_max_pd(hi, v);
+    }
+    double ls[4], la[4], lq[4], lm[4], llo[4], lhi[4];
+    _mm256_storeu_pd(ls, s);
+    _mm256_storeu_pd(la, a);
+    _mm256_storeu_pd(lq, q);
+    _mm256_storeu_pd(lm, m);
+    _mm256_storeu_pd(llo, lo);
+    _mm256_storeu_pd(lhi, hi);
+#else
+    double ls[4] = {0, 0, 0, 0}, la[4] = {0, 0, 0, 0}, lq[4] = {0, 0, 0, 0};
+    double lm[4] = {0, 0, 0, 0};
+    double llo[4] = {x[0], x[0], x[0], x[0]}, lhi[4] = {x[0], x[0], x[0], x[0]};
+    for (; j + 4 <= n; j += 4) {
+        for (size_t l = 0; l < 4; l++) {
+            const double v = x[j + l];
+            const double av = fabs(v);
+            ls[l] += v;
+            la[l] += av;
+            lq[l] += v * v;
+            if (av > lm[l]) lm[l] = av;
+            if (v < llo[l]) llo[l] = v;
+            if (v > lhi[l]) lhi[l] = v;
+        }
+    }
+#endif
+    b->sum = (ls[0] + ls[2]) + (ls[1] + ls[3]);
+    b->asum = (la[0] + la[2]) + (la[1] + la[3]);
+    b->ssq = (lq[0] + lq[2]) + (lq[1] + lq[3]);
+    b->amax = fmax(fmax(lm[0], lm[1]), fmax(lm[2], lm[3]));
+    b->min = fmin(fmin(llo[0], llo[1]), fmin(llo[2], llo[3]));
+    b->max = fmax(fmax(lhi[0], lhi[1]), fmax(lhi[2], lhi[3]));
+    for (; j < n; j++) {
+        const double v = x[j];
+        b->sum += v;
+        b->asum += fabs(v);
+        b->ssq += v * v;
+        if (fabs(v) > b->amax) b->amax = fabs(v);
+        if (v < b->min) b->min = v;
+        if (v > b->max) b->max = v;
+    }
+}
+
+void la_kern_row_stats(size_t n, const double *x, la_kern_rstats *out) {
+    double cs = 0.0, ca = 0.0, cq = 0.0;
+    la_kern_rstats r;
+    stats_block(n < LA_KERN_STATS_BLOCK ? n : LA_KERN_STATS_BLOCK, x, &r);
+
+    for (size_t j = LA_KERN_STATS_BLOCK; j < n; j += LA_KERN_STATS_BLOCK) {
+        const size_t len = (n - j < LA_KERN_STATS_BLOCK) ? n - j : LA_KERN_STATS_BLOCK;
+        la_kern_rstats b;
+        stats_block(len, x + j, &b);
+        r.sum = la_kern_sum2(r.sum, b.sum, &cs);
+        r.asum = la_kern_sum2(r.asum, b.asum, &ca);
+        r.ssq = la_kern_sum2(r.ssq, b.ssq, &cq);
+        if (b.amax > r.amax) r.amax = b.amax;
+        if (b.min < r.min) r.min = b.min;
+        if (b.max > r.max) r.max = b.max;
+    }
+
+    r.sum += cs;
+    r.asum += ca;
+    r.ssq += cq;
+    *out = r;
+}
+
+void la_kern_norms(size_t m, size_t n, const double *A, size_t lda,
+                   double *maxabs_out, double *norm1_out) {
+    double maxabs = 0.0;
+    double norm1 = 0.0;
+
+    for (size_t j = 0; j < n; j++) {
+        double colsum = 0.0;
+        for (size_t i = 0; i < m; i++) {
+            const double v = fabs(A[i * lda + j]);
+            colsum += v;
+            if (v > maxabs) maxabs = v;
+        }
+        if (colsum > norm1) norm1 = colsum;
+    }
+
+    *maxabs_out = maxabs;
+    *norm1_out = norm1;
+}
+
+void la_kern_gemm(size_t m, size_t n, size_t k, double alpha,
+                  const double *A, size_t lda, const double *B, size_t ldb,
+                  double *C, size_t ldc) {
+    // i-p-j order keeps the inner loop contiguous in B and C
+    for (size_t i = 0; i < m; i++) {
+        double *c = C + i * ldc;
+        for (size_t p = 0; p < k; p++) {
+            const double a = alpha * A[i * lda + p];
+            const double *b = B + p * ldb;
+            for (size_t j = 0; j < n; j++) {
+                c[j] += a * b[j];
+            }
+        }
+    }
+}
+
+void la_kern_gemm_nt(size_t m, size_t n, size_t k, double alpha,
+                     const double *A, size_t lda, const double *B, size_t ldb,
+                     double *C, size_t ldc) {
+    for (size_t i = 0; i < m; i++) {
+        const double *a = A + i * lda;
+        for (size_t j = 0; j < n; j++) {
+            const double *b = B + j * ldb;
+            double sum = 0.0;
+            for (size_t p = 0; p < k; p++) {
+                sum += a[p] * b[p];
+            }
+            C[i * ldc + j] += alpha * sum;
+        }
+    }
+}
+
+void la_kern_trsm_lower_unit(size_t m, size_t n, const double *L, size_t ldl,
+                             double *X, size_t ldx) {
+    for (size_t i = 1; i < m; i++) {
+        for (size_t p = 0; p < i; p++) {
+            const double l = L[i * ldl + p];
+            for (size_t j = 0; j < n; j++) {
+                X[i * ldx + j] -= l * X[p * ldx + j];
+            }
+        }
+    }
+}
+
+void la_kern_trsm_upper(size_t m, size_t n, const double *U, size_t ldu,
+                        double *X, size_t ldx) {
+    for (size_t i = m; i-- > 0;) {
+        for (size_t p = i + 1; p < m; p++) {
+            const double u = U[i * ldu + p];
+            for (size_t j = 0; j < n; j++) {
+                X[i * ldx + j] -= u * X[p * ldx + j];
+            }
+        }
+        const double d = U[i * ldu + i];
+        for (size_t j = 0; j < n; j++) {
+            X[i * ldx + j] /= d;
+        }
+    }
+}
+
+void la_kern_trsm_right_lower_trans(size_t m, size_t n, const double *L, size_t ldl,
+                                    double *X, size_t ldx) {
+    // Each row x solves L x^T = b^T by forward substitution
+    for (size_t i = 0; i < m; i++) {
+        double *x = X + i * ldx;
+        for (size_t j = 0; j < n; j++) {
+            const double *l = L + j * ldl;
+            double v = x[j];
+            for (size_t p = 0; p < j; p++) {
+                v -= l[p] * x[p];
+            }
+            x[j] = v / l[j];
+        }
+    }
+}
+
+int la_kern_getf2(size_t m, size_t w, double *P, size_t ldp, double tol, size_t *piv) {
+    for (size_t c = 0; c < w && c < m; c++) {
+        size_t best_r = c;
+        double best = fabs(P[c * ldp + c]);
+        for (size_t r = c + 1; r < m; r++) {
+            const double v = fabs(P[r * ldp + c]);
+            if (v > best) {
+                best = v;
+                best_r = r;
+            }
+        }
+        if (best < tol) return 0;
+
+        piv[c] = best_r;
+        if (best_r != c) {
+            for (size_t j = 0; j < w; j++) {
+                double tmp = P[c * ldp + j];
+                P[c * ldp + j] = P[best_r * ldp + j];
+                P[best_r * ldp + j] = tmp;
+            }
+        }
+
+        const double pivot = P[c * ldp + c];
+        for (size_t r = c + 1; r < m; r++) {
+            const double factor = P[r * ldp + c] / pivot;
+            P[r * ldp + c] = factor;
+            for (size_t j = c + 1; j < w; j++) {
+                P[r * ldp + j] -= factor * P[c * ldp + j];
+            }
+        }
+    }
+    return 1;
+}
+
+int la_kern_potf2(size_t n, double *A, size_t lda) {
+    for (size_t j = 0; j < n; j++) {
+        double *aj = A + j * lda;
+        double d = aj[j];
+        for (size_t p = 0; p < j; p++) {
+            d -= aj[p] * aj[p];
+        }
+        if (!(d > 0.0)) return 0;
+        d = sqrt(d);
+        aj[j] = d;
+
+        for (size_t i = j + 1; i < n; i++) {
+            double *ai = A + i * lda;
+            double v = ai[j];
+            for (size_t p = 0; p < j; p++) {
+                v -= ai[p] * aj[p];
+            }
+            ai[j] = v / d;
+        }
+    }
+    return 1;
+}
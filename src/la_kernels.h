@@ -0,0 +1,75 @@
+#ifndef LA_KERNELS_H
+#define LA_KERNELS_H
+
+#include <stddef.h>  // size_t
+
+// Internal dense kernels on row-major blocks with explicit leading
+// dimensions, shared by the tiled (la_par) and out-of-core (la_ooc) paths.
+
+// Largest absolute entry and 1-norm (max column sum) of an m x n block
+void la_kern_norms(size_t m, size_t n, const double *A, size_t lda,
+                   double *maxabs_out, double *norm1_out);
+
+// y += a * x over n contiguous entries. Uses AVX2/FMA when the library is
+// built for a target that has them (e.g. -DLA_NATIVE=ON).
+void la_kern_axpy(size_t n, double a, const double *x, double *y);
+
+// Dot product of n contiguous entries, accumulated in four interleaved
+// partial sums (AVX2 lanes when available).
+double la_kern_dot(size_t n, const double *x, const double *y);
+
+// Sums and extrema of one contiguous run of n > 0 entries.
+typedef struct {
+  double sum;   // sum x
+  double asum;  // sum |x|
+  double ssq;   // sum x^2
+  double amax;  // max |x|
+  double min;
+  double max;
+} la_kern_rstats;
+
+// Blocks of LA_KERN_STATS_BLOCK entries are summed in four lanes and the
+// block totals are combined with compensated (Neumaier) summation, so the
+// error grows with the block size rather than with n.
+#define LA_KERN_STATS_BLOCK 128
+void la_kern_row_stats(size_t n, const double *x, la_kern_rstats *out);
+
+// s + v with the rounding error carried in *c (Neumaier)
+static inline double la_kern_sum2(double s, double v, double *c) {
+    const double t = s + v;
+    if ((s >= 0 ? s : -s) >= (v >= 0 ? v : -v)) *c += (s - t) + v;
+    else *c += (v - t) + s;
+    return t;
+}
+
+// C += alpha * A * B, with A m x k and B k x n
+void la_kern_gemm(size_t m, size_t n, size_t k, double alpha,
+                  const double *A, size_t lda, const double *B, size_t ldb,
+                  double *C, size_t ldc);
+
+// C += alpha * A * B^T, with A m x k and B n x k
+void la_kern_gemm_nt(size_t m, size_t n, size_t k, double alpha,
+                     const double *A, size_t lda, const double *B, size_t ldb,
+                     double *C, size_t ldc);
+
+// X := L^-1 X, with L m x m unit lower triangular and X m x n
+void la_kern_trsm_lower_unit(size_t m, size_t n, const double *L, size_t ldl,
+                             double *X, size_t ldx);
+
+// X := U^-1 X, with U m x m upper triangular and X m x n
+void la_kern_trsm_upper(size_t m, size_t n, const double *U, size_t ldu,
+                        double *X, size_t ldx);
+
+// X := X L^-T, with L n x n lower triangular and X m x n
+void la_kern_trsm_right_lower_trans(size_t m, size_t n, const double *L, size_t ldl,
+                                    double *X, size_t ldx);
+
+// Unblocked LU with partial pivoting of an m x w panel. piv[c] receives the
+// panel-local row swapped with row c. Returns 0 if a pivot is below tol.
+int la_kern_getf2(size_t m, size_t w, double *P, size_t ldp, double tol, size_t *piv);
+
+// Unblocked Cholesky (lower) of an n x n block in place. Only the lower
+// triangle is referenced. Returns 0 if the block is not positive definite.
+int la_kern_potf2(size_t n, double *A, size_t lda);
+
+#endif
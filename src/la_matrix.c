@@ -1,5 +1,15 @@
 #include "la_matrix.h"
-#include <stdlib.h> 
+#include "la_matrix_internal.h"
+#include "la_prof_internal.h"
+#include <stdlib.h>
+#include <string.h> // memcpy
+
+// Edge of the blocks a row-major <-> column-major conversion moves at once
+static const size_t LA_CONVERT_BLOCK = 32;
+
+static size_t tiled_storage(size_t rows, size_t cols, size_t b) {
+    return ((rows + b - 1) / b) * ((cols + b - 1) / b) * b * b;
+}
 
 la_status la_matrix_init(Matrix *m, size_t rows, size_t cols) {
     if (!m || rows == 0 || cols == 0) return LA_ERR_DIM;
@@ -13,25 +23,140 @@ la_status la_matrix_init(Matrix *m, size_t rows, size_t cols) {
         m->cols = 0;
         return LA_ERR_ALLOC;
     }
+    LA_PROF_ALLOC(rows * cols * sizeof(double));
+    return LA_OK;
+}
+
+la_status la_matrix_init_layout(Matrix *m, size_t rows, size_t cols, la_layout layout,
+                                size_t tile) {
+    if (!m || rows == 0 || cols == 0) return LA_ERR_DIM;
+    if (layout != LA_ROW_MAJOR && layout != LA_COL_MAJOR && layout != LA_TILED) {
+        return LA_ERR_DIM;
+    }
+    if (layout != LA_TILED) {
+        la_status st = la_matrix_init(m, rows, cols);
+        if (st == LA_OK) m->layout = layout;
+        return st;
+    }
+
+    la_matrix_reset(m);
+    const size_t b = tile ? tile : LA_TILE_DEFAULT;
+    const size_t count = tiled_storage(rows, cols, b);
+    m->data = (double *)calloc(count, sizeof(double));
+    if (!m->data) return LA_ERR_ALLOC;
+    LA_PROF_ALLOC(count * sizeof(double));
+
+    m->rows = rows;
+    m->cols = cols;
+    m->layout = LA_TILED;
+    m->tile = b;
+    return LA_OK;
+}
+
+la_status la_matrix_wrap(Matrix *m, size_t rows, size_t cols, double *data,
+                         la_layout layout, size_t tile) {
+    if (!m || !data || rows == 0 || cols == 0) return LA_ERR_DIM;
+    if (layout != LA_ROW_MAJOR && layout != LA_COL_MAJOR && layout != LA_TILED) {
+        return LA_ERR_DIM;
+    }
+
+    la_matrix_reset(m);
+    m->rows = rows;
+    m->cols = cols;
+    m->data = data;
+    m->layout = layout;
+    m->tile = (layout == LA_TILED) ? (tile ? tile : LA_TILE_DEFAULT) : 0;
+    m->borrowed = 1;
     return LA_OK;
 }
 
+size_t la_matrix_storage(const Matrix *m) {
+    if (!m) return 0;
+    if (m->layout == LA_TILED) return tiled_storage(m->rows, m->cols, m->tile);
+    return m->rows * m->cols;
+}
+
 void la_matrix_free(Matrix *m) {
     if (!m) return;
-    free(m->data);
-    m->data = NULL;
-    m->rows = 0;
-    m->cols = 0;
+    if (!m->borrowed) free(m->data);
+    la_matrix_reset(m);
+}
+
+// dst[j * rows + i] = src[i * cols + j], in cache-sized blocks
+static void transpose_blocked(double *dst, const double *src, size_t rows, size_t cols) {
+    const size_t nb = LA_CONVERT_BLOCK;
+    for (size_t i0 = 0; i0 < rows; i0 += nb) {
+        const size_t i1 = (i0 + nb < rows) ? i0 + nb : rows;
+        for (size_t j0 = 0; j0 < cols; j0 += nb) {
+            const size_t j1 = (j0 + nb < cols) ? j0 + nb : cols;
+            for (size_t i = i0; i < i1; i++) {
+                for (size_t j = j0; j < j1; j++) {
+                    dst[j * rows + i] = src[i * cols + j];
+                }
+            }
+        }
+    }
+}
+
+// Copies the entries of src into dst, which has the same shape
+static void store_entries(Matrix *dst, const Matrix *src) {
+    const size_t rows = src->rows;
+    const size_t cols = src->cols;
+
+    if (dst->layout == src->layout && dst->tile == src->tile) {
+        memcpy(dst->data, src->data, la_matrix_storage(src) * sizeof(double));
+    } else if (src->layout == LA_ROW_MAJOR && dst->layout == LA_COL_MAJOR) {
+        transpose_blocked(dst->data, src->data, rows, cols);
+    } else if (src->layout == LA_COL_MAJOR && dst->layout == LA_ROW_MAJOR) {
+        transpose_blocked(dst->data, src->data, cols, rows);
+    } else if (src->layout == LA_ROW_MAJOR) {
+        // Into tiles: each tile row is a contiguous run of the source row
+        const size_t b = dst->tile;
+        for (size_t i = 0; i < rows; i++) {
+            for (size_t j0 = 0; j0 < cols; j0 += b) {
+                const size_t len = (cols - j0 < b) ? cols - j0 : b;
+                memcpy(&LA_REF(dst, i, j0), &LA_AT(src, i, j0), len * sizeof(double));
+            }
+        }
+    } else if (dst->layout == LA_ROW_MAJOR) {
+        const size_t b = src->tile;
+        for (size_t i = 0; i < rows; i++) {
+            for (size_t j0 = 0; j0 < cols; j0 += b) {
+                const size_t len = (cols - j0 < b) ? cols - j0 : b;
+                memcpy(&LA_AT(dst, i, j0), &LA_REF(src, i, j0), len * sizeof(double));
+            }
+        }
+    } else {
+        for (size_t i = 0; i < rows; i++) {
+            for (size_t j = 0; j < cols; j++) {
+                LA_REF(dst, i, j) = LA_REF(src, i, j);
+            }
+        }
+    }
+}
+
+la_status la_matrix_convert(Matrix *dst, const Matrix *src, la_layout layout, size_t tile) {
+    if (!dst || !src || !src->data) return LA_ERR_DIM;
+    if (dst->data != NULL) return LA_ERR_DIM;
+    if (layout != LA_ROW_MAJOR && layout != LA_COL_MAJOR && layout != LA_TILED) {
+        return LA_ERR_DIM;
+    }
+
+    la_status st = la_matrix_init_layout(dst, src->rows, src->cols, layout, tile);
+    if (st != LA_OK) return st;
+
+    store_entries(dst, src);
+    return LA_OK;
 }
 
 la_status la_matrix_copy(Matrix *dst, const Matrix *src) {
     if (!dst || !src) return LA_ERR_DIM;
     if (src->rows == 0 || src->cols == 0 || !src->data) return LA_ERR_DIM;
 
-    la_status st = la_matrix_init(dst, src->rows, src->cols);
+    la_status st = la_matrix_init_layout(dst, src->rows, src->cols, src->layout, src->tile);
     if (st != LA_OK) return st;
 
-    size_t n = src->rows * src->cols;
+    size_t n = la_matrix_storage(src);
     for (size_t k = 0; k < n; k++) {
         dst->data[k] = src->data[k];
     }
@@ -40,6 +165,15 @@ la_status la_matrix_copy(Matrix *dst, const Matrix *src) {
 
 void la_matrix_fill(Matrix *m, double value) {
     if (!m || !m->data) return;
+    if (m->layout == LA_TILED) {
+        // Leave the tile padding at zero
+        for (size_t i = 0; i < m->rows; i++) {
+            for (size_t j = 0; j < m->cols; j++) {
+                LA_REF(m, i, j) = value;
+            }
+        }
+        return;
+    }
     size_t n = m->rows * m->cols;
     for (size_t k = 0; k < n; k++) {
         m->data[k] = value;
@@ -51,4 +185,55 @@ void la_matrix_reset(Matrix *m) {
     m->rows = 0;
     m->cols = 0;
     m->data = NULL;
+    m->layout = LA_ROW_MAJOR;
+    m->tile = 0;
+    m->borrowed = 0;
+}
+
+// ---------------- Layout fallbacks ----------------
+
+Matrix la_matrix_storage_view(const Matrix *m) {
+    Matrix v = *m;
+    if (m->layout == LA_COL_MAJOR) {
+        v.rows = m->cols;
+        v.cols = m->rows;
+    }
+    v.layout = LA_ROW_MAJOR;
+    v.tile = 0;
+    v.borrowed = 1;
+    return v;
+}
+
+la_status la_matrix_row_major(const Matrix *A, Matrix *tmp, const Matrix **view) {
+    la_matrix_reset(tmp);
+    if (A->layout == LA_ROW_MAJOR) {
+        *view = A;
+        return LA_OK;
+    }
+    if (A->layout == LA_COL_MAJOR && (A->rows == 1 || A->cols == 1)) {
+        // A column-major vector is stored exactly like a row-major one
+        *tmp = la_matrix_storage_view(A);
+        tmp->rows = A->rows;
+        tmp->cols = A->cols;
+        *view = tmp;
+        return LA_OK;
+    }
+
+    la_status st = la_matrix_convert(tmp, A, LA_ROW_MAJOR, 0);
+    if (st != LA_OK) return st;
+    *view = tmp;
+    return LA_OK;
+}
+
+la_status la_matrix_row_major_inout(Matrix *M, Matrix *tmp, Matrix **work) {
+    const Matrix *view = NULL;
+    la_status st = la_matrix_row_major(M, tmp, &view);
+    if (st != LA_OK) return st;
+    *work = (view == M) ? M : tmp;
+    return LA_OK;
+}
+
+void la_matrix_commit(Matrix *M, Matrix *tmp) {
+    if (tmp->data && !tmp->borrowed) store_entries(M, tmp);
+    la_matrix_free(tmp);
 }
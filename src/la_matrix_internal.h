@@ -0,0 +1,22 @@
+#ifndef LA_MATRIX_INTERNAL_H
+#define LA_MATRIX_INTERNAL_H
+
+#include "la_matrix.h"
+
+// Layout fallbacks for code written against row-major storage (LA_AT).
+
+// m's data as a borrowed row-major matrix: m itself for row-major, m^T
+// (cols x rows) for column-major. Not meaningful for LA_TILED.
+Matrix la_matrix_storage_view(const Matrix *m);
+
+// *view is A when it is row-major, otherwise a row-major copy held in *tmp
+// (column-major vectors are aliased, not copied). Call la_matrix_free(tmp)
+// when done with *view.
+la_status la_matrix_row_major(const Matrix *A, Matrix *tmp, const Matrix **view);
+
+// Same for a matrix updated in place: work on *work, then la_matrix_commit
+// stores the result back into M's own layout and frees tmp.
+la_status la_matrix_row_major_inout(Matrix *M, Matrix *tmp, Matrix **work);
+void la_matrix_commit(Matrix *M, Matrix *tmp);
+
+#endif
@@ -0,0 +1,672 @@
+#define _FILE_OFFSET_BITS 64
+#define _POSIX_C_SOURCE 200809L  // pread, pwrite, ftruncate
+#include "la_ooc.h"
+#include "la_kernels.h"
+#include "la_prof_internal.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Same "effectively zero" pivot tolerance as la_solve
+static const double LA_EPS = 1e-12;
+
+typedef enum {
+  SLOT_EMPTY = 0,
+  SLOT_BUSY,   // being written back and/or loaded
+  SLOT_READY
+} slot_state;
+
+typedef struct {
+  double *buf;
+  size_t tile_id;
+  slot_state state;
+  int pins;
+  int dirty;
+  unsigned long long stamp;  // LRU clock value of the last access
+} ooc_slot;
+
+struct la_ooc_matrix {
+  int fd;
+  size_t rows, cols;
+  size_t tile;
+  size_t tr, tc;  // tile grid
+
+  ooc_slot *slots;
+  size_t nslots;
+  int *slot_of;  // tile id -> slot index, -1 if not cached
+  unsigned long long clock;
+
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+
+  // Prefetch queue served by io_thread
+  pthread_t io_thread;
+  pthread_cond_t io_cond;
+  size_t *queue;
+  size_t qhead, qlen;
+  int stop;
+
+  int io_error;
+  la_ooc_stats stats;
+};
+
+// ---------------- Tile I/O ----------------
+
+static size_t tile_rows(const la_ooc_matrix *m, size_t ti) {
+    size_t r = m->rows - ti * m->tile;
+    return r < m->tile ? r : m->tile;
+}
+
+static size_t tile_cols(const la_ooc_matrix *m, size_t tj) {
+    size_t c = m->cols - tj * m->tile;
+    return c < m->tile ? c : m->tile;
+}
+
+static size_t tile_bytes(const la_ooc_matrix *m) {
+    return m->tile * m->tile * sizeof(double);
+}
+
+static int io_full(int fd, double *buf, size_t bytes, off_t off, int write) {
+    char *p = (char *)buf;
+    while (bytes > 0) {
+        ssize_t k = write ? pwrite(fd, p, bytes, off) : pread(fd, p, bytes, off);
+        if (k < 0 && errno == EINTR) continue;
+        if (k <= 0) return 0;
+        p += k;
+        bytes -= (size_t)k;
+        off += k;
+    }
+    return 1;
+}
+
+static int read_tile(la_ooc_matrix *m, size_t id, double *buf) {
+    return io_full(m->fd, buf, tile_bytes(m), (off_t)(id * tile_bytes(m)), 0);
+}
+
+static int write_tile(la_ooc_matrix *m, size_t id, double *buf) {
+    return io_full(m->fd, buf, tile_bytes(m), (off_t)(id * tile_bytes(m)), 1);
+}
+
+// ---------------- Tile cache ----------------
+
+// Least recently used slot that is not pinned or in flight, -1 if none
+static int pick_victim(const la_ooc_matrix *m) {
+    int best = -1;
+    for (size_t s = 0; s < m->nslots; s++) {
+        const ooc_slot *sl = &m->slots[s];
+        if (sl->state == SLOT_EMPTY) return (int)s;
+        if (sl->state != SLOT_READY || sl->pins > 0) continue;
+        if (best < 0 || sl->stamp < m->slots[best].stamp) best = (int)s;
+    }
+    return best;
+}
+
+// Returns the cached buffer of tile id, loading it if needed.
+//  - pin:       keep the tile resident until cache_release
+//  - need_read: 0 when the caller overwrites the whole tile
+//  - prefetch:  never block; give up if the tile is in flight or no slot is free
+static double *cache_get(la_ooc_matrix *m, size_t id, int pin, int need_read, int prefetch) {
+    pthread_mutex_lock(&m->lock);
+
+    int v = -1;
+    for (;;) {
+        int s = m->slot_of[id];
+        if (s >= 0) {
+            ooc_slot *sl = &m->slots[s];
+            if (sl->state == SLOT_READY && sl->tile_id == id) {
+                if (!prefetch) m->stats.hits++;
+                sl->pins += pin;
+                sl->stamp = ++m->clock;
+                pthread_mutex_unlock(&m->lock);
+                return sl->buf;
+            }
+        } else {
+            v = pick_victim(m);
+            if (v >= 0) break;
+        }
+        if (prefetch) {
+            pthread_mutex_unlock(&m->lock);
+            return NULL;
+        }
+        pthread_cond_wait(&m->cond, &m->lock);
+    }
+
+    ooc_slot *sl = &m->slots[v];
+    const int had_old = (sl->state == SLOT_READY);
+    const int old_dirty = sl->dirty;
+    const size_t old_id = sl->tile_id;
+
+    // Claim the slot for id; waiters on either tile block until it settles
+    sl->state = SLOT_BUSY;
+    sl->tile_id = id;
+    sl->dirty = 0;
+    sl->pins = pin;
+    sl->stamp = ++m->clock;
+    m->slot_of[id] = v;
+    if (prefetch) m->stats.prefetches++;
+    else m->stats.misses++;
+    pthread_mutex_unlock(&m->lock);
+
+    int ok = 1;
+    if (had_old && old_dirty) {
+        ok = write_tile(m, old_id, sl->buf);
+    }
+
+    pthread_mutex_lock(&m->lock);
+    if (had_old) {
+        // The file is current again, so requests for old_id may reload it
+        m->slot_of[old_id] = -1;
+        if (old_dirty) m->stats.tile_writes++;
+        pthread_cond_broadcast(&m->cond);
+    }
+    pthread_mutex_unlock(&m->lock);
+
+    if (need_read) {
+        ok = read_tile(m, id, sl->buf) && ok;
+    }
+
+    pthread_mutex_lock(&m->lock);
+    if (need_read) m->stats.tile_reads++;
+    if (!ok) m->io_error = 1;
+    sl->state = SLOT_READY;
+    pthread_cond_broadcast(&m->cond);
+    pthread_mutex_unlock(&m->lock);
+    return sl->buf;
+}
+
+static double *tile_acquire(la_ooc_matrix *m, size_t ti, size_t tj, int need_read) {
+    return cache_get(m, ti * m->tc + tj, 1, need_read, 0);
+}
+
+static void tile_release(la_ooc_matrix *m, size_t ti, size_t tj, int dirty) {
+    pthread_mutex_lock(&m->lock);
+    ooc_slot *sl = &m->slots[m->slot_of[ti * m->tc + tj]];
+    if (dirty) sl->dirty = 1;
+    if (--sl->pins == 0) pthread_cond_broadcast(&m->cond);
+    pthread_mutex_unlock(&m->lock);
+}
+
+// Queue an asynchronous load of tile (ti, tj); silently dropped when the
+// tile is already cached or the queue is full.
+static void tile_prefetch(la_ooc_matrix *m, size_t ti, size_t tj) {
+    if (ti >= m->tr || tj >= m->tc) return;
+    const size_t id = ti * m->tc + tj;
+
+    pthread_mutex_lock(&m->lock);
+    if (m->slot_of[id] < 0 && m->qlen < m->nslots) {
+        m->queue[(m->qhead + m->qlen) % m->nslots] = id;
+        m->qlen++;
+        pthread_cond_signal(&m->io_cond);
+    }
+    pthread_mutex_unlock(&m->lock);
+}
+
+static void *io_main(void *arg) {
+    la_ooc_matrix *m = (la_ooc_matrix *)arg;
+
+    pthread_mutex_lock(&m->lock);
+    for (;;) {
+        while (!m->stop && m->qlen == 0) {
+            pthread_cond_wait(&m->io_cond, &m->lock);
+        }
+        if (m->stop) break;
+
+        size_t id = m->queue[m->qhead];
+        m->qhead = (m->qhead + 1) % m->nslots;
+        m->qlen--;
+
+        pthread_mutex_unlock(&m->lock);
+        cache_get(m, id, 0, 1, 1);
+        pthread_mutex_lock(&m->lock);
+    }
+    pthread_mutex_unlock(&m->lock);
+    return NULL;
+}
+
+// ---------------- Lifecycle ----------------
+
+static void ooc_free(la_ooc_matrix *m) {
+    if (m->slots) {
+        for (size_t s = 0; s < m->nslots; s++) {
+            free(m->slots[s].buf);
+        }
+    }
+    free(m->slots);
+    free(m->slot_of);
+    free(m->queue);
+    free(m);
+}
+
+static la_status ooc_new(la_ooc_matrix **out, int fd, size_t rows, size_t cols,
+                         size_t tile, size_t cache_tiles) {
+    la_ooc_matrix *m = (la_ooc_matrix *)calloc(1, sizeof(*m));
+    if (!m) return LA_ERR_ALLOC;
+
+    m->fd = fd;
+    m->rows = rows;
+    m->cols = cols;
+    m->tile = tile;
+    m->tr = (rows + tile - 1) / tile;
+    m->tc = (cols + tile - 1) / tile;
+    m->nslots = cache_tiles;
+
+    m->slots = (ooc_slot *)calloc(cache_tiles, sizeof(ooc_slot));
+    m->slot_of = (int *)malloc(m->tr * m->tc * sizeof(int));
+    m->queue = (size_t *)malloc(cache_tiles * sizeof(size_t));
+    int ok = m->slots && m->slot_of && m->queue;
+
+    for (size_t s = 0; ok && s < cache_tiles; s++) {
+        m->slots[s].buf = (double *)malloc(tile_bytes(m));
+        ok = (m->slots[s].buf != NULL);
+    }
+    if (!ok) {
+        ooc_free(m);
+        return LA_ERR_ALLOC;
+    }
+    LA_PROF_ALLOC(cache_tiles * tile_bytes(m));
+
+    for (size_t t = 0; t < m->tr * m->tc; t++) {
+        m->slot_of[t] = -1;
+    }
+
+    pthread_mutex_init(&m->lock, NULL);
+    pthread_cond_init(&m->cond, NULL);
+    pthread_cond_init(&m->io_cond, NULL);
+    if (pthread_create(&m->io_thread, NULL, io_main, m) != 0) {
+        pthread_mutex_destroy(&m->lock);
+        pthread_cond_destroy(&m->cond);
+        pthread_cond_destroy(&m->io_cond);
+        ooc_free(m);
+        return LA_ERR_ALLOC;
+    }
+
+    *out = m;
+    return LA_OK;
+}
+
+static int ooc_args_ok(la_ooc_matrix **out, const char *path, size_t rows, size_t cols,
+                       size_t tile, size_t cache_tiles) {
+    return out && path && rows > 0 && cols > 0 && tile > 0 &&
+           cache_tiles >= LA_OOC_MIN_CACHE_TILES;
+}
+
+la_status la_ooc_create(la_ooc_matrix **out, const char *path, size_t rows,
+                        size_t cols, size_t tile, size_t cache_tiles) {
+    if (!ooc_args_ok(out, path, rows, cols, tile, cache_tiles)) return LA_ERR_DIM;
+
+    const size_t ntiles = ((rows + tile - 1) / tile) * ((cols + tile - 1) / tile);
+
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return LA_ERR_IO;
+    if (ftruncate(fd, (off_t)(ntiles * tile * tile * sizeof(double))) != 0) {
+        close(fd);
+        return LA_ERR_IO;
+    }
+
+    la_status st = ooc_new(out, fd, rows, cols, tile, cache_tiles);
+    if (st != LA_OK) close(fd);
+    return st;
+}
+
+la_status la_ooc_open(la_ooc_matrix **out, const char *path, size_t rows,
+                      size_t cols, size_t tile, size_t cache_tiles) {
+    if (!ooc_args_ok(out, path, rows, cols, tile, cache_tiles)) return LA_ERR_DIM;
+
+    const size_t ntiles = ((rows + tile - 1) / tile) * ((cols + tile - 1) / tile);
+
+    int fd = open(path, O_RDWR);
+    if (fd < 0) return LA_ERR_IO;
+
+    struct stat sb;
+    if (fstat(fd, &sb) != 0) {
+        close(fd);
+        return LA_ERR_IO;
+    }
+    if ((size_t)sb.st_size != ntiles * tile * tile * sizeof(double)) {
+        close(fd);
+        return LA_ERR_DIM;
+    }
+
+    la_status st = ooc_new(out, fd, rows, cols, tile, cache_tiles);
+    if (st != LA_OK) close(fd);
+    return st;
+}
+
+la_status la_ooc_flush(la_ooc_matrix *m) {
+    if (!m) return LA_ERR_DIM;
+
+    pthread_mutex_lock(&m->lock);
+    for (size_t s = 0; s < m->nslots; s++) {
+        ooc_slot *sl = &m->slots[s];
+        if (sl->state == SLOT_READY && sl->dirty) {
+            if (!write_tile(m, sl->tile_id, sl->buf)) m->io_error = 1;
+            sl->dirty = 0;
+            m->stats.tile_writes++;
+        }
+    }
+    if (fsync(m->fd) != 0) m->io_error = 1;
+    la_status st = m->io_error ? LA_ERR_IO : LA_OK;
+    pthread_mutex_unlock(&m->lock);
+    return st;
+}
+
+la_status la_ooc_close(la_ooc_matrix *m) {
+    if (!m) return LA_ERR_DIM;
+
+    pthread_mutex_lock(&m->lock);
+    m->stop = 1;
+    pthread_cond_signal(&m->io_cond);
+    pthread_mutex_unlock(&m->lock);
+    pthread_join(m->io_thread, NULL);
+
+    la_status st = la_ooc_flush(m);
+    close(m->fd);
+
+    pthread_mutex_destroy(&m->lock);
+    pthread_cond_destroy(&m->cond);
+    pthread_cond_destroy(&m->io_cond);
+    ooc_free(m);
+    return st;
+}
+
+la_status la_ooc_get_stats(la_ooc_matrix *m, la_ooc_stats *out) {
+    if (!m || !out) return LA_ERR_DIM;
+    pthread_mutex_lock(&m->lock);
+    *out = m->stats;
+    pthread_mutex_unlock(&m->lock);
+    return LA_OK;
+}
+
+// Reports (and clears) any tile I/O failure since the last check
+static la_status take_io_status(la_ooc_matrix *m) {
+    pthread_mutex_lock(&m->lock);
+    la_status st = m->io_error ? LA_ERR_IO : LA_OK;
+    m->io_error = 0;
+    pthread_mutex_unlock(&m->lock);
+    return st;
+}
+
+// ---------------- Block import / export ----------------
+
+la_status la_ooc_write_block(la_ooc_matrix *m, size_t row0, size_t col0, const Matrix *src) {
+    if (!m || !src || !src->data) return LA_ERR_DIM;
+    if (row0 + src->rows > m->rows || col0 + src->cols > m->cols) return LA_ERR_DIM;
+
+    const size_t b = m->tile;
+    const size_t ti0 = row0 / b, ti1 = (row0 + src->rows - 1) / b;
+    const size_t tj0 = col0 / b, tj1 = (col0 + src->cols - 1) / b;
+
+    for (size_t ti = ti0; ti <= ti1; ti++) {
+        for (size_t tj = tj0; tj <= tj1; tj++) {
+            const size_t r0 = (ti * b > row0) ? ti * b : row0;
+            const size_t r1 = (ti * b + b < row0 + src->rows) ? ti * b + b : row0 + src->rows;
+            const size_t c0 = (tj * b > col0) ? tj * b : col0;
+            const size_t c1 = (tj * b + b < col0 + src->cols) ? tj * b + b : col0 + src->cols;
+
+            // Only read the old tile when part of it survives
+            const int full = (r1 - r0 == tile_rows(m, ti)) && (c1 - c0 == tile_cols(m, tj));
+            double *t = tile_acquire(m, ti, tj, !full);
+
+            for (size_t r = r0; r < r1; r++) {
+                for (size_t c = c0; c < c1; c++) {
+                    t[(r - ti * b) * b + (c - tj * b)] = LA_REF(src, r - row0, c - col0);
+                }
+            }
+            tile_release(m, ti, tj, 1);
+        }
+    }
+    return take_io_status(m);
+}
+
+la_status la_ooc_read_block(Matrix *dst, la_ooc_matrix *m, size_t row0, size_t col0,
+                            size_t rows, size_t cols) {
+    if (!dst || !m) return LA_ERR_DIM;
+    if (dst->data != NULL) return LA_ERR_DIM;
+    if (rows == 0 || cols == 0) return LA_ERR_DIM;
+    if (row0 + rows > m->rows || col0 + cols > m->cols) return LA_ERR_DIM;
+
+    la_status st = la_matrix_init(dst, rows, cols);
+    if (st != LA_OK) return st;
+
+    const size_t b = m->tile;
+    for (size_t ti = row0 / b; ti <= (row0 + rows - 1) / b; ti++) {
+        for (size_t tj = col0 / b; tj <= (col0 + cols - 1) / b; tj++) {
+            const size_t r0 = (ti * b > row0) ? ti * b : row0;
+            const size_t r1 = (ti * b + b < row0 + rows) ? ti * b + b : row0 + rows;
+            const size_t c0 = (tj * b > col0) ? tj * b : col0;
+            const size_t c1 = (tj * b + b < col0 + cols) ? tj * b + b : col0 + cols;
+
+            tile_prefetch(m, ti, tj + 1);
+            const double *t = tile_acquire(m, ti, tj, 1);
+            for (size_t r = r0; r < r1; r++) {
+                for (size_t c = c0; c < c1; c++) {
+                    LA_AT(dst, r - row0, c - col0) = t[(r - ti * b) * b + (c - tj * b)];
+                }
+            }
+            tile_release(m, ti, tj, 0);
+        }
+    }
+
+    st = take_io_status(m);
+    if (st != LA_OK) la_matrix_free(dst);
+    return st;
+}
+
+// ---------------- Out-of-core kernels ----------------
+
+la_status la_ooc_mul(la_ooc_matrix *C, la_ooc_matrix *A, la_ooc_matrix *B) {
+    if (!C || !A || !B) return LA_ERR_DIM;
+    if (A->cols != B->rows || C->rows != A->rows || C->cols != B->cols) return LA_ERR_DIM;
+    if (A->tile != B->tile || A->tile != C->tile) return LA_ERR_DIM;
+    if (C == A || C == B) return LA_ERR_DIM;
+
+    const size_t b = A->tile;
+    const size_t kt = A->tc;
+
+    for (size_t ti = 0; ti < C->tr; ti++) {
+        for (size_t tj = 0; tj < C->tc; tj++) {
+            double *c = tile_acquire(C, ti, tj, 0);
+            memset(c, 0, tile_bytes(C));
+
+            const size_t mr = tile_rows(C, ti);
+            const size_t nc = tile_cols(C, tj);
+
+            for (size_t p = 0; p < kt; p++) {
+                // Prefetch the operands of the next step while this one runs
+                if (p + 1 < kt) {
+                    tile_prefetch(A, ti, p + 1);
+                    tile_prefetch(B, p + 1, tj);
+                } else if (tj + 1 < C->tc) {
+                    tile_prefetch(B, 0, tj + 1);
+                } else {
+                    tile_prefetch(A, ti + 1, 0);
+                    tile_prefetch(B, 0, 0);
+                }
+
+                const double *a = tile_acquire(A, ti, p, 1);
+                const double *bt = tile_acquire(B, p, tj, 1);
+
+                la_kern_gemm(mr, nc, tile_cols(A, p), 1.0, a, b, bt, b, c, b);
+
+                tile_release(A, ti, p, 0);
+                tile_release(B, p, tj, 0);
+            }
+            tile_release(C, ti, tj, 1);
+        }
+    }
+
+    la_status st = take_io_status(A);
+    if (take_io_status(B) != LA_OK) st = LA_ERR_IO;
+    if (take_io_status(C) != LA_OK) st = LA_ERR_IO;
+    return st;
+}
+
+// Swap global rows r1 and r2 inside tile column tj
+static void swap_tile_rows(la_ooc_matrix *A, size_t tj, size_t r1, size_t r2) {
+    const size_t b = A->tile;
+    const size_t t1 = r1 / b, t2 = r2 / b;
+    const size_t w = tile_cols(A, tj);
+
+    double *a = tile_acquire(A, t1, tj, 1);
+    double *c = tile_acquire(A, t2, tj, 1);
+    double *x = a + (r1 % b) * b;
+    double *y = c + (r2 % b) * b;
+    for (size_t j = 0; j < w; j++) {
+        double tmp = x[j];
+        x[j] = y[j];
+        y[j] = tmp;
+    }
+    tile_release(A, t2, tj, 1);
+    tile_release(A, t1, tj, 1);
+}
+
+// Right-looking blocked LU: one tile column (panel) at a time. The panel is
+// factored in memory; the trailing tile columns are streamed through the
+// cache. Row interchanges are applied to the trailing columns only, so the
+// stored L is in "per-step" order and ipiv must be replayed step by step.
+static la_status ooc_lu(la_ooc_matrix *A, double *P, size_t *ipiv) {
+    const size_t b = A->tile;
+    const size_t n = A->rows;
+    const size_t nt = A->tr;
+
+    for (size_t k = 0; k < nt; k++) {
+        const size_t r0 = k * b;
+        const size_t w = tile_cols(A, k);
+        const size_t m = n - r0;
+
+        // Gather panel k (rows r0..n-1) into P
+        for (size_t ti = k; ti < nt; ti++) {
+            tile_prefetch(A, ti + 1, k);
+            const double *t = tile_acquire(A, ti, k, 1);
+            for (size_t i = 0; i < tile_rows(A, ti); i++) {
+                memcpy(P + (ti * b - r0 + i) * w, t + i * b, w * sizeof(double));
+            }
+            tile_release(A, ti, k, 0);
+        }
+
+        if (!la_kern_getf2(m, w, P, w, LA_EPS, ipiv + r0)) return LA_ERR_SINGULAR;
+        for (size_t c = 0; c < w; c++) {
+            ipiv[r0 + c] += r0;
+        }
+
+        // Scatter the factored panel back
+        for (size_t ti = k; ti < nt; ti++) {
+            double *t = tile_acquire(A, ti, k, 0);
+            for (size_t i = 0; i < tile_rows(A, ti); i++) {
+                memcpy(t + i * b, P + (ti * b - r0 + i) * w, w * sizeof(double));
+            }
+            tile_release(A, ti, k, 1);
+        }
+
+        // Trailing update, one tile column at a time
+        for (size_t tj = k + 1; tj < A->tc; tj++) {
+            for (size_t c = 0; c < w; c++) {
+                if (ipiv[r0 + c] != r0 + c) swap_tile_rows(A, tj, r0 + c, ipiv[r0 + c]);
+            }
+
+            const size_t nc = tile_cols(A, tj);
+            tile_prefetch(A, k + 1, tj);
+            double *u = tile_acquire(A, k, tj, 1);
+            la_kern_trsm_lower_unit(w, nc, P, w, u, b);
+
+            for (size_t ti = k + 1; ti < nt; ti++) {
+                if (ti + 1 < nt) tile_prefetch(A, ti + 1, tj);
+                else tile_prefetch(A, k, tj + 1);
+
+                double *t = tile_acquire(A, ti, tj, 1);
+                la_kern_gemm(tile_rows(A, ti), nc, w, -1.0, P + (ti * b - r0) * w, w, u, b, t, b);
+                tile_release(A, ti, tj, 1);
+            }
+            tile_release(A, k, tj, 1);
+        }
+    }
+    return LA_OK;
+}
+
+la_status la_ooc_solve(Matrix *X_out, la_ooc_matrix *A, const Matrix *B) {
+    if (!X_out || !A || !B || !B->data) return LA_ERR_DIM;
+    if (X_out->data != NULL) return LA_ERR_DIM;
+    if (A->rows != A->cols || B->rows != A->rows) return LA_ERR_DIM;
+
+    const size_t n = A->rows;
+    const size_t b = A->tile;
+    const size_t nt = A->tr;
+    const size_t k = B->cols;
+
+    double *P = (double *)malloc(n * b * sizeof(double));
+    size_t *ipiv = (size_t *)malloc(n * sizeof(size_t));
+    if (!P || !ipiv) {
+        free(P);
+        free(ipiv);
+        return LA_ERR_ALLOC;
+    }
+    LA_PROF_ALLOC(n * b * sizeof(double) + n * sizeof(size_t));
+
+    la_status st = ooc_lu(A, P, ipiv);
+    free(P);
+    if (st == LA_OK) st = take_io_status(A);
+    if (st == LA_OK) st = la_matrix_convert(X_out, B, LA_ROW_MAJOR, 0);
+    if (st != LA_OK) {
+        free(ipiv);
+        return st;
+    }
+
+    // Forward: replay each step's interchanges, then eliminate with L(:,tk)
+    for (size_t tk = 0; tk < nt; tk++) {
+        const size_t r0 = tk * b;
+        const size_t w = tile_rows(A, tk);
+
+        for (size_t c = 0; c < w; c++) {
+            const size_t r = ipiv[r0 + c];
+            if (r == r0 + c) continue;
+            for (size_t j = 0; j < k; j++) {
+                double tmp = LA_AT(X_out, r0 + c, j);
+                LA_AT(X_out, r0 + c, j) = LA_AT(X_out, r, j);
+                LA_AT(X_out, r, j) = tmp;
+            }
+        }
+
+        tile_prefetch(A, tk + 1, tk);
+        const double *d = tile_acquire(A, tk, tk, 1);
+        la_kern_trsm_lower_unit(w, k, d, b, &LA_AT(X_out, r0, 0), k);
+        tile_release(A, tk, tk, 0);
+
+        for (size_t ti = tk + 1; ti < nt; ti++) {
+            tile_prefetch(A, ti + 1, tk);
+            const double *l = tile_acquire(A, ti, tk, 1);
+            la_kern_gemm(tile_rows(A, ti), k, w, -1.0, l, b, &LA_AT(X_out, r0, 0), k,
+                         &LA_AT(X_out, ti * b, 0), k);
+            tile_release(A, ti, tk, 0);
+        }
+    }
+
+    // Backward: column-oriented substitution with U
+    for (size_t tk = nt; tk-- > 0;) {
+        const size_t r0 = tk * b;
+        const size_t w = tile_rows(A, tk);
+
+        const double *d = tile_acquire(A, tk, tk, 1);
+        la_kern_trsm_upper(w, k, d, b, &LA_AT(X_out, r0, 0), k);
+        tile_release(A, tk, tk, 0);
+
+        for (size_t ti = 0; ti < tk; ti++) {
+            if (ti + 1 < tk) tile_prefetch(A, ti + 1, tk);
+            else if (tk > 0) tile_prefetch(A, tk - 1, tk - 1);
+
+            const double *u = tile_acquire(A, ti, tk, 1);
+            la_kern_gemm(tile_rows(A, ti), k, w, -1.0, u, b, &LA_AT(X_out, r0, 0), k,
+                         &LA_AT(X_out, ti * b, 0), k);
+            tile_release(A, ti, tk, 0);
+        }
+    }
+
+    free(ipiv);
+    st = take_io_status(A);
+    if (st != LA_OK) la_matrix_free(X_out);
+    return st;
+}
@@ -1,4 +1,45 @@
 #include "la_ops.h"
+#include "la_kernels.h"
+#include "la_matrix_internal.h"
+#include "la_prof_internal.h"
+#include <string.h> // memcpy
+
+static int same_layout(const Matrix *a, const Matrix *b) {
+    return a->layout == b->layout && a->tile == b->tile;
+}
+
+// out = a + sign * b. Operands sharing a layout are combined straight
+// through their storage and out keeps that layout; otherwise out is
+// row-major.
+static la_status add_sub(Matrix *out, const Matrix *a, const Matrix *b, double sign) {
+    if (same_layout(a, b)) {
+        la_status st = la_matrix_init_layout(out, a->rows, a->cols, a->layout, a->tile);
+        if (st != LA_OK) return st;
+
+        const size_t n = la_matrix_storage(a);
+        for (size_t k = 0; k < n; k++) {
+            out->data[k] = a->data[k] + sign * b->data[k];
+        }
+        return LA_OK;
+    }
+
+    Matrix ta = (Matrix){0}, tb = (Matrix){0};
+    const Matrix *ra = NULL, *rb = NULL;
+    la_status st = la_matrix_row_major(a, &ta, &ra);
+    if (st == LA_OK) st = la_matrix_row_major(b, &tb, &rb);
+    if (st == LA_OK) st = la_matrix_init(out, a->rows, a->cols);
+
+    if (st == LA_OK) {
+        for (size_t i = 0; i < a->rows; i++) {
+            for (size_t j = 0; j < a->cols; j++) {
+                LA_AT(out, i, j) = LA_AT(ra, i, j) + sign * LA_AT(rb, i, j);
+            }
+        }
+    }
+    la_matrix_free(&ta);
+    la_matrix_free(&tb);
+    return st;
+}
 
 la_status la_add(Matrix *out, const Matrix *a, const Matrix *b) {
     if (!out || !a || !b) return LA_ERR_DIM;
@@ -6,14 +47,12 @@ la_status la_add(Matrix *out, const Matrix *a, const Matrix *b) {
     if (out->data != NULL) return LA_ERR_DIM;
     if (a->rows != b->rows || a->cols != b->cols) return LA_ERR_DIM;
 
-    la_status st = la_matrix_init(out, a->rows, a->cols);
+    LA_PROF_BEGIN(prof);
+
+    la_status st = add_sub(out, a, b, 1.0);
     if (st != LA_OK) return st;
 
-    for (size_t i = 0; i < a->rows; i++) {
-        for (size_t j = 0; j < a->cols; j++) {
-            LA_AT(out, i, j) = LA_AT(a, i, j) + LA_AT(b, i, j);
-        }
-    }
+    LA_PROF_END(prof, LA_PROF_ADD, a->rows * a->cols);
     return LA_OK;
 }
 
@@ -23,14 +62,12 @@ la_status la_sub(Matrix *out, const Matrix *a, const Matrix *b) {
     if (out->data != NULL) return LA_ERR_DIM;
     if (a->rows != b->rows || a->cols != b->cols) return LA_ERR_DIM;
 
-    la_status st = la_matrix_init(out, a->rows, a->cols);
+    LA_PROF_BEGIN(prof);
+
+    la_status st = add_sub(out, a, b, -1.0);
     if (st != LA_OK) return st;
 
-    for (size_t i = 0; i < a->rows; i++) {
-        for (size_t j = 0; j < a->cols; j++) {
-            LA_AT(out, i, j) = LA_AT(a, i, j) - LA_AT(b, i, j);
-        }
-    }
+    LA_PROF_END(prof, LA_PROF_SUB, a->rows * a->cols);
     return LA_OK;
 }
 
@@ -39,34 +76,87 @@ la_status la_transpose(Matrix *out, const Matrix *a) {
     if (!a->data) return LA_ERR_DIM;
     if (out->data != NULL) return LA_ERR_DIM;
 
+    LA_PROF_BEGIN(prof);
+
     la_status st = la_matrix_init(out, a->cols, a->rows);
     if (st != LA_OK) return st;
 
-    for (size_t i = 0; i < a->rows; i++) {
-        for (size_t j = 0; j < a->cols; j++) {
-            LA_AT(out, j, i) = LA_AT(a, i, j);
+    if (a->layout == LA_COL_MAJOR) {
+        // Column-major a is stored exactly as row-major a^T
+        memcpy(out->data, a->data, a->rows * a->cols * sizeof(double));
+    } else {
+        for (size_t i = 0; i < a->rows; i++) {
+            for (size_t j = 0; j < a->cols; j++) {
+                LA_AT(out, j, i) = LA_REF(a, i, j);
+            }
         }
     }
+    LA_PROF_END(prof, LA_PROF_TRANSPOSE, 0);
     return LA_OK;
 }
 
+// c = a * b for row-major a (m x k), b (k x n) and c (m x n)
+static void mul_rows(const double *a, const double *b, double *c, size_t m, size_t k,
+                     size_t n) {
+    for (size_t i = 0; i < m; i++) {
+        for (size_t j = 0; j < n; j++) {
+            double sum = 0.0;
+            for (size_t p = 0; p < k; p++) {
+                sum += a[i * k + p] * b[p * n + j];
+            }
+            c[i * n + j] = sum;
+        }
+    }
+}
+
+// out = a * b tile by tile; the zero padding makes every tile full-sized
+static void mul_tiled(Matrix *out, const Matrix *a, const Matrix *b) {
+    const size_t t = a->tile;
+    const size_t tt = t * t;
+    const size_t tm = (a->rows + t - 1) / t;
+    const size_t tk = (a->cols + t - 1) / t;
+    const size_t tn = (b->cols + t - 1) / t;
+
+    for (size_t i = 0; i < tm; i++) {
+        for (size_t j = 0; j < tn; j++) {
+            double *c = out->data + (i * tn + j) * tt;
+            for (size_t p = 0; p < tk; p++) {
+                la_kern_gemm(t, t, t, 1.0, a->data + (i * tk + p) * tt, t,
+                             b->data + (p * tn + j) * tt, t, c, t);
+            }
+        }
+    }
+}
+
 la_status la_mul(Matrix *out, const Matrix *a, const Matrix *b) {
     if (!out || !a || !b) return LA_ERR_DIM;
     if (!a->data || !b->data) return LA_ERR_DIM;
     if (out->data != NULL) return LA_ERR_DIM;
     if (a->cols != b->rows) return LA_ERR_DIM;
 
-    la_status st = la_matrix_init(out, a->rows, b->cols);
-    if (st != LA_OK) return st;
+    LA_PROF_BEGIN(prof);
 
-    for (size_t i = 0; i < out->rows; i++) {
-        for (size_t j = 0; j < out->cols; j++) {
-            double sum = 0.0;
-            for (size_t k = 0; k < a->cols; k++) {
-                sum += LA_AT(a, i, k) * LA_AT(b, k, j);
-            }
-            LA_AT(out, i, j) = sum;
-        }
+    la_status st = LA_OK;
+    if (same_layout(a, b) && a->layout == LA_TILED) {
+        st = la_matrix_init_layout(out, a->rows, b->cols, LA_TILED, a->tile);
+        if (st != LA_OK) return st;
+        mul_tiled(out, a, b);
+    } else if (same_layout(a, b) && a->layout == LA_COL_MAJOR) {
+        // Stored transposed: out^T = b^T a^T, with out column-major
+        st = la_matrix_init_layout(out, a->rows, b->cols, LA_COL_MAJOR, 0);
+        if (st != LA_OK) return st;
+        mul_rows(b->data, a->data, out->data, b->cols, a->cols, a->rows);
+    } else {
+        Matrix ta = (Matrix){0}, tb = (Matrix){0};
+        const Matrix *ra = NULL, *rb = NULL;
+        st = la_matrix_row_major(a, &ta, &ra);
+        if (st == LA_OK) st = la_matrix_row_major(b, &tb, &rb);
+        if (st == LA_OK) st = la_matrix_init(out, a->rows, b->cols);
+        if (st == LA_OK) mul_rows(ra->data, rb->data, out->data, a->rows, a->cols, b->cols);
+        la_matrix_free(&ta);
+        la_matrix_free(&tb);
+        if (st != LA_OK) return st;
     }
+    LA_PROF_END(prof, LA_PROF_MUL, 2 * a->rows * a->cols * b->cols);
     return LA_OK;
 }
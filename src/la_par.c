@@ -0,0 +1,456 @@
+#include "la_par.h"
+#include "la_kernels.h"
+#include "la_matrix_internal.h"
+#include "la_task.h"
+
+#include <float.h>   // DBL_EPSILON
+#include <stdlib.h>  // malloc, free
+
+static const size_t LA_PAR_DEFAULT_TILE = 128;
+
+// Shared state of one tiled factorization or product
+typedef struct {
+  double *a;         // row-major n x n (or C for la_par_mul)
+  size_t ld;
+  size_t n;
+  size_t b;          // tile edge
+  size_t nt;         // tiles per dimension
+  size_t *ipiv;      // LU: global row swapped with row r at step r / b
+  double tol;        // LU: absolute pivot threshold
+  size_t lookahead;
+} tiled_ctx;
+
+typedef struct {
+  const tiled_ctx *c;
+  size_t k, i, j;
+} tile_task;
+
+static size_t tile_dim(const tiled_ctx *c, size_t t) {
+    size_t r = c->n - t * c->b;
+    return r < c->b ? r : c->b;
+}
+
+static double *tile_ptr(const tiled_ctx *c, size_t i, size_t j) {
+    return c->a + i * c->b * c->ld + j * c->b;
+}
+
+static void resolve_opts(const la_par_opts *opts, size_t *nthreads, size_t *tile,
+                         size_t *lookahead) {
+    *nthreads = opts ? opts->nthreads : 0;
+    *tile = (opts && opts->tile > 0) ? opts->tile : LA_PAR_DEFAULT_TILE;
+    *lookahead = (opts && opts->lookahead > 0) ? opts->lookahead : 1;
+}
+
+// Tasks writing the current panel column and the next `lookahead` columns
+// go first; everything else in the trailing update follows, earlier
+// columns before later ones.
+static int column_priority(const tiled_ctx *c, size_t k, size_t j) {
+    if (j <= k + c->lookahead) return (int)(3 * c->nt - j);
+    return (int)(c->nt - j);
+}
+
+// ---------------- LU ----------------
+
+static la_status lu_panel_task(void *arg) {
+    const tile_task *t = (const tile_task *)arg;
+    const tiled_ctx *c = t->c;
+    const size_t r0 = t->k * c->b;
+    const size_t w = tile_dim(c, t->k);
+
+    if (!la_kern_getf2(c->n - r0, w, tile_ptr(c, t->k, t->k), c->ld, c->tol, c->ipiv + r0)) {
+        return LA_ERR_SINGULAR;
+    }
+    for (size_t cc = 0; cc < w; cc++) {
+        c->ipiv[r0 + cc] += r0;
+    }
+    return LA_OK;
+}
+
+// Apply panel k's interchanges to tile column j, then U(k,j) = L(k,k)^-1 A(k,j)
+static la_status lu_swap_trsm_task(void *arg) {
+    const tile_task *t = (const tile_task *)arg;
+    const tiled_ctx *c = t->c;
+    const size_t r0 = t->k * c->b;
+    const size_t w = tile_dim(c, t->k);
+    const size_t wj = tile_dim(c, t->j);
+    double *col = c->a + t->j * c->b;
+
+    for (size_t cc = 0; cc < w; cc++) {
+        const size_t r2 = c->ipiv[r0 + cc];
+        if (r2 == r0 + cc) continue;
+        double *x = col + (r0 + cc) * c->ld;
+        double *y = col + r2 * c->ld;
+        for (size_t j = 0; j < wj; j++) {
+            double tmp = x[j];
+            x[j] = y[j];
+            y[j] = tmp;
+        }
+    }
+
+    la_kern_trsm_lower_unit(w, wj, tile_ptr(c, t->k, t->k), c->ld, tile_ptr(c, t->k, t->j), c->ld);
+    return LA_OK;
+}
+
+// A(i,j) -= L(i,k) U(k,j)
+static la_status lu_gemm_task(void *arg) {
+    const tile_task *t = (const tile_task *)arg;
+    const tiled_ctx *c = t->c;
+
+    la_kern_gemm(tile_dim(c, t->i), tile_dim(c, t->j), tile_dim(c, t->k), -1.0,
+                 tile_ptr(c, t->i, t->k), c->ld, tile_ptr(c, t->k, t->j), c->ld,
+                 tile_ptr(c, t->i, t->j), c->ld);
+    return LA_OK;
+}
+
+static la_status lu_submit(la_graph *g, const tiled_ctx *c, la_access *acc) {
+    const size_t nt = c->nt;
+    la_status st = LA_OK;
+
+    for (size_t k = 0; k < nt && st == LA_OK; k++) {
+        tile_task t = {c, k, k, k};
+
+        size_t na = 0;
+        for (size_t i = k; i < nt; i++) {
+            acc[na++] = (la_access){i * nt + k, 1};
+        }
+        st = la_graph_submit(g, lu_panel_task, &t, sizeof(t), column_priority(c, k, k), acc, na);
+
+        for (size_t j = k + 1; j < nt && st == LA_OK; j++) {
+            t.j = j;
+
+            na = 0;
+            acc[na++] = (la_access){k * nt + k, 0};
+            for (size_t i = k; i < nt; i++) {
+                acc[na++] = (la_access){i * nt + j, 1};
+            }
+            st = la_graph_submit(g, lu_swap_trsm_task, &t, sizeof(t),
+                                 column_priority(c, k, j), acc, na);
+
+            for (size_t i = k + 1; i < nt && st == LA_OK; i++) {
+                t.i = i;
+                acc[0] = (la_access){i * nt + k, 0};
+                acc[1] = (la_access){k * nt + j, 0};
+                acc[2] = (la_access){i * nt + j, 1};
+                st = la_graph_submit(g, lu_gemm_task, &t, sizeof(t),
+                                     column_priority(c, k, j), acc, 3);
+            }
+        }
+    }
+    return st;
+}
+
+la_status la_par_lu_factor(la_lu *f, const Matrix *A, const la_par_opts *opts) {
+    if (!f || !A || !A->data) return LA_ERR_DIM;
+    if (A->rows != A->cols) return LA_ERR_DIM;
+
+    if (A->layout != LA_ROW_MAJOR) {
+        Matrix tmp = (Matrix){0};
+        const Matrix *R = NULL;
+        la_status st = la_matrix_row_major(A, &tmp, &R);
+        if (st == LA_OK) st = la_par_lu_factor(f, R, opts);
+        la_matrix_free(&tmp);
+        return st;
+    }
+
+    la_matrix_reset(&f->LU);
+    f->perm = NULL;
+    f->sign = 1;
+
+    const size_t n = A->rows;
+    size_t nthreads, tile, lookahead;
+    resolve_opts(opts, &nthreads, &tile, &lookahead);
+
+    double maxabs = 0.0;
+    la_kern_norms(n, n, A->data, n, &maxabs, &f->anorm);
+    if (maxabs == 0.0) return LA_ERR_SINGULAR;
+
+    const double rel = (opts && opts->pivot_tol > 0.0) ? opts->pivot_tol
+                                                       : (double)n * DBL_EPSILON;
+
+    la_status st = la_matrix_copy(&f->LU, A);
+    if (st != LA_OK) return st;
+
+    tiled_ctx c = {0};
+    c.a = f->LU.data;
+    c.ld = n;
+    c.n = n;
+    c.b = tile;
+    c.nt = (n + tile - 1) / tile;
+    c.tol = rel * maxabs;
+    c.lookahead = lookahead;
+
+    c.ipiv = (size_t *)malloc(n * sizeof(size_t));
+    f->perm = (size_t *)malloc(n * sizeof(size_t));
+    la_access *acc = (la_access *)malloc((c.nt + 1) * sizeof(la_access));
+    la_graph *g = la_graph_create(c.nt * c.nt, nthreads);
+
+    if (!c.ipiv || !f->perm || !acc || !g) {
+        st = LA_ERR_ALLOC;
+    } else {
+        st = lu_submit(g, &c, acc);
+        if (st == LA_OK) st = la_graph_run(g);
+    }
+    la_graph_destroy(g);
+    free(acc);
+
+    if (st != LA_OK) {
+        free(c.ipiv);
+        la_lu_free(f);
+        return st;
+    }
+
+    // The trailing columns saw every interchange as it happened; replay them
+    // on the L part to the left of each panel and build the permutation.
+    for (size_t i = 0; i < n; i++) {
+        f->perm[i] = i;
+    }
+    for (size_t r = 0; r < n; r++) {
+        const size_t r2 = c.ipiv[r];
+        if (r2 == r) continue;
+
+        const size_t left = (r / tile) * tile;
+        double *x = f->LU.data + r * n;
+        double *y = f->LU.data + r2 * n;
+        for (size_t j = 0; j < left; j++) {
+            double tmp = x[j];
+            x[j] = y[j];
+            y[j] = tmp;
+        }
+
+        size_t tmp = f->perm[r];
+        f->perm[r] = f->perm[r2];
+        f->perm[r2] = tmp;
+        f->sign = -f->sign;
+    }
+
+    free(c.ipiv);
+    return LA_OK;
+}
+
+la_status la_par_det(double *det_out, const Matrix *A, const la_par_opts *opts) {
+    if (!det_out || !A || !A->data) return LA_ERR_DIM;
+    if (A->rows != A->cols) return LA_ERR_DIM;
+
+    la_lu f = {0};
+    la_status st = la_par_lu_factor(&f, A, opts);
+    if (st == LA_ERR_SINGULAR) {
+        *det_out = 0.0;
+        return LA_ERR_SINGULAR;
+    }
+    if (st != LA_OK) return st;
+
+    double det = (double)f.sign;
+    for (size_t i = 0; i < f.LU.rows; i++) {
+        det *= LA_AT(&f.LU, i, i);
+    }
+
+    la_lu_free(&f);
+    *det_out = det;
+    return LA_OK;
+}
+
+la_status la_par_solve(Matrix *x_out, const Matrix *A, const Matrix *b, const la_par_opts *opts) {
+    if (!x_out || !A || !b || !A->data || !b->data) return LA_ERR_DIM;
+    if (x_out->data != NULL) return LA_ERR_DIM;
+
+    la_matrix_reset(x_out);
+
+    if (A->rows != A->cols) return LA_ERR_DIM;
+    if (b->cols != 1) return LA_ERR_DIM;
+    if (b->rows != A->rows) return LA_ERR_DIM;
+
+    la_lu f = {0};
+    la_status st = la_par_lu_factor(&f, A, opts);
+    if (st != LA_OK) return st;
+
+    st = la_lu_solve(x_out, &f, b);
+    la_lu_free(&f);
+    return st;
+}
+
+// ---------------- Cholesky ----------------
+
+static la_status chol_potrf_task(void *arg) {
+    const tile_task *t = (const tile_task *)arg;
+    const tiled_ctx *c = t->c;
+
+    if (!la_kern_potf2(tile_dim(c, t->k), tile_ptr(c, t->k, t->k), c->ld)) {
+        return LA_ERR_SINGULAR;
+    }
+    return LA_OK;
+}
+
+// L(i,k) = A(i,k) L(k,k)^-T
+static la_status chol_trsm_task(void *arg) {
+    const tile_task *t = (const tile_task *)arg;
+    const tiled_ctx *c = t->c;
+
+    la_kern_trsm_right_lower_trans(tile_dim(c, t->i), tile_dim(c, t->k),
+                                   tile_ptr(c, t->k, t->k), c->ld,
+                                   tile_ptr(c, t->i, t->k), c->ld);
+    return LA_OK;
+}
+
+// A(i,j) -= L(i,k) L(j,k)^T (j == i is the symmetric rank-k update)
+static la_status chol_update_task(void *arg) {
+    const tile_task *t = (const tile_task *)arg;
+    const tiled_ctx *c = t->c;
+
+    la_kern_gemm_nt(tile_dim(c, t->i), tile_dim(c, t->j), tile_dim(c, t->k), -1.0,
+                    tile_ptr(c, t->i, t->k), c->ld, tile_ptr(c, t->j, t->k), c->ld,
+                    tile_ptr(c, t->i, t->j), c->ld);
+    return LA_OK;
+}
+
+static la_status chol_submit(la_graph *g, const tiled_ctx *c) {
+    const size_t nt = c->nt;
+    la_status st = LA_OK;
+
+    for (size_t k = 0; k < nt && st == LA_OK; k++) {
+        tile_task t = {c, k, k, k};
+        la_access acc[3];
+
+        acc[0] = (la_access){k * nt + k, 1};
+        st = la_graph_submit(g, chol_potrf_task, &t, sizeof(t), column_priority(c, k, k), acc, 1);
+
+        for (size_t i = k + 1; i < nt && st == LA_OK; i++) {
+            t.i = i;
+            acc[0] = (la_access){k * nt + k, 0};
+            acc[1] = (la_access){i * nt + k, 1};
+            st = la_graph_submit(g, chol_trsm_task, &t, sizeof(t), column_priority(c, k, k), acc, 2);
+        }
+
+        for (size_t j = k + 1; j < nt && st == LA_OK; j++) {
+            for (size_t i = j; i < nt && st == LA_OK; i++) {
+                t.i = i;
+                t.j = j;
+                size_t na = 0;
+                acc[na++] = (la_access){i * nt + k, 0};
+                if (j != i) acc[na++] = (la_access){j * nt + k, 0};
+                acc[na++] = (la_access){i * nt + j, 1};
+                st = la_graph_submit(g, chol_update_task, &t, sizeof(t),
+                                     column_priority(c, k, j), acc, na);
+            }
+        }
+    }
+    return st;
+}
+
+la_status la_par_cholesky(Matrix *L_out, const Matrix *A, const la_par_opts *opts) {
+    if (!L_out || !A || !A->data) return LA_ERR_DIM;
+    if (L_out->data != NULL) return LA_ERR_DIM;
+    if (A->rows != A->cols) return LA_ERR_DIM;
+
+    if (A->layout != LA_ROW_MAJOR) {
+        Matrix tmp = (Matrix){0};
+        const Matrix *R = NULL;
+        la_status st = la_matrix_row_major(A, &tmp, &R);
+        if (st == LA_OK) st = la_par_cholesky(L_out, R, opts);
+        la_matrix_free(&tmp);
+        return st;
+    }
+
+    const size_t n = A->rows;
+    size_t nthreads, tile, lookahead;
+    resolve_opts(opts, &nthreads, &tile, &lookahead);
+
+    la_status st = la_matrix_copy(L_out, A);
+    if (st != LA_OK) return st;
+
+    tiled_ctx c = {0};
+    c.a = L_out->data;
+    c.ld = n;
+    c.n = n;
+    c.b = tile;
+    c.nt = (n + tile - 1) / tile;
+    c.lookahead = lookahead;
+
+    la_graph *g = la_graph_create(c.nt * c.nt, nthreads);
+    if (!g) {
+        st = LA_ERR_ALLOC;
+    } else {
+        st = chol_submit(g, &c);
+        if (st == LA_OK) st = la_graph_run(g);
+    }
+    la_graph_destroy(g);
+
+    if (st != LA_OK) {
+        la_matrix_free(L_out);
+        return st;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = i + 1; j < n; j++) {
+            LA_AT(L_out, i, j) = 0.0;
+        }
+    }
+    return LA_OK;
+}
+
+// ---------------- GEMM ----------------
+
+typedef struct {
+  const Matrix *a;
+  const Matrix *b;
+  Matrix *out;
+  size_t tile;
+  size_t i, j;
+} mul_task;
+
+// out(i,j) = a(i,:) b(:,j), accumulated in the same order as la_mul
+static la_status mul_tile_task(void *arg) {
+    const mul_task *t = (const mul_task *)arg;
+    const size_t r0 = t->i * t->tile;
+    const size_t c0 = t->j * t->tile;
+    const size_t m = (t->out->rows - r0 < t->tile) ? t->out->rows - r0 : t->tile;
+    const size_t n = (t->out->cols - c0 < t->tile) ? t->out->cols - c0 : t->tile;
+
+    la_kern_gemm(m, n, t->a->cols, 1.0,
+                 &LA_AT(t->a, r0, 0), t->a->cols, &LA_AT(t->b, 0, c0), t->b->cols,
+                 &LA_AT(t->out, r0, c0), t->out->cols);
+    return LA_OK;
+}
+
+la_status la_par_mul(Matrix *out, const Matrix *a, const Matrix *b, const la_par_opts *opts) {
+    if (!out || !a || !b) return LA_ERR_DIM;
+    if (!a->data || !b->data) return LA_ERR_DIM;
+    if (out->data != NULL) return LA_ERR_DIM;
+    if (a->cols != b->rows) return LA_ERR_DIM;
+
+    if (a->layout != LA_ROW_MAJOR || b->layout != LA_ROW_MAJOR) {
+        Matrix ta = (Matrix){0}, tb = (Matrix){0};
+        const Matrix *ra = NULL, *rb = NULL;
+        la_status st = la_matrix_row_major(a, &ta, &ra);
+        if (st == LA_OK) st = la_matrix_row_major(b, &tb, &rb);
+        if (st == LA_OK) st = la_par_mul(out, ra, rb, opts);
+        la_matrix_free(&ta);
+        la_matrix_free(&tb);
+        return st;
+    }
+
+    size_t nthreads, tile, lookahead;
+    resolve_opts(opts, &nthreads, &tile, &lookahead);
+
+    la_status st = la_matrix_init(out, a->rows, b->cols);
+    if (st != LA_OK) return st;
+    la_matrix_fill(out, 0.0);
+
+    const size_t tr = (out->rows + tile - 1) / tile;
+    const size_t tc = (out->cols + tile - 1) / tile;
+
+    // Output tiles are independent: no accesses, no edges
+    la_graph *g = la_graph_create(0, nthreads);
+    if (!g) st = LA_ERR_ALLOC;
+
+    for (size_t i = 0; i < tr && st == LA_OK; i++) {
+        for (size_t j = 0; j < tc && st == LA_OK; j++) {
+            mul_task t = {a, b, out, tile, i, j};
+            st = la_graph_submit(g, mul_tile_task, &t, sizeof(t), 0, NULL, 0);
+        }
+    }
+    if (st == LA_OK) st = la_graph_run(g);
+    la_graph_destroy(g);
+
+    if (st != LA_OK) la_matrix_free(out);
+    return st;
+}
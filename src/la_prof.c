@@ -0,0 +1,240 @@
+#define _GNU_SOURCE  // syscall, clock_gettime
+#include "la_prof_internal.h"
+
+#ifdef LA_PROFILE
+
+#include <stdatomic.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <pthread.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Indices into the hardware counter group
+enum { HW_CACHE_MISSES = 0, HW_CYCLES = 1, HW_INSTRUCTIONS = 2, HW_COUNT = 3 };
+
+typedef struct {
+  atomic_ullong calls;
+  atomic_ullong bytes_alloc;
+  atomic_ullong time_ns;
+  atomic_ullong flops;
+  atomic_ullong hw[HW_COUNT];
+} prof_slot;
+
+static prof_slot g_slots[LA_PROF_OP_COUNT];
+
+_Thread_local unsigned long long la_prof_thread_bytes = 0;
+
+// Per-thread perf_event group, leader first: -1 = not yet opened,
+// -2 = unavailable or closed
+static _Thread_local int t_hw_fds[HW_COUNT] = {-1, -1, -1};
+
+static unsigned long long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ull + (unsigned long long)ts.tv_nsec;
+}
+
+#ifdef __linux__
+static int perf_open(unsigned long long config, int group_fd) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = (group_fd == -1);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+// Thread-exit destructor: worker threads come and go with every task
+// graph run, so each must release its group or the fds pile up.
+static pthread_key_t g_hw_key;
+static pthread_once_t g_hw_once = PTHREAD_ONCE_INIT;
+static int g_hw_key_ok = 0;
+
+static void hw_close(void *arg) {
+    int *fds = (int *)arg;
+    for (int i = 0; i < HW_COUNT; i++) {
+        if (fds[i] >= 0) close(fds[i]);
+        fds[i] = -2;
+    }
+}
+
+static void hw_key_init(void) {
+    g_hw_key_ok = (pthread_key_create(&g_hw_key, hw_close) == 0);
+}
+
+static int hw_group(void) {
+    if (t_hw_fds[0] != -1) return t_hw_fds[0];
+    t_hw_fds[0] = -2;
+
+    // Without a destructor the group could not be closed; go without
+    pthread_once(&g_hw_once, hw_key_init);
+    if (!g_hw_key_ok) return -2;
+
+    int fds[HW_COUNT];
+    fds[0] = perf_open(PERF_COUNT_HW_CACHE_MISSES, -1);
+    if (fds[0] < 0) return -2;
+    fds[1] = perf_open(PERF_COUNT_HW_CPU_CYCLES, fds[0]);
+    fds[2] = perf_open(PERF_COUNT_HW_INSTRUCTIONS, fds[0]);
+    if (fds[1] < 0 || fds[2] < 0 || pthread_setspecific(g_hw_key, t_hw_fds) != 0) {
+        for (int i = 0; i < HW_COUNT; i++) {
+            if (fds[i] >= 0) close(fds[i]);
+        }
+        return -2;
+    }
+
+    ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    for (int i = 0; i < HW_COUNT; i++) {
+        t_hw_fds[i] = fds[i];
+    }
+    return t_hw_fds[0];
+}
+
+static int hw_read(unsigned long long out[HW_COUNT]) {
+    int fd = hw_group();
+    if (fd < 0) return 0;
+
+    // PERF_FORMAT_GROUP layout: nr, then one value per counter
+    unsigned long long buf[1 + HW_COUNT];
+    if (read(fd, buf, sizeof(buf)) != (ssize_t)sizeof(buf) || buf[0] != HW_COUNT) {
+        return 0;
+    }
+    for (int i = 0; i < HW_COUNT; i++) {
+        out[i] = buf[1 + i];
+    }
+    return 1;
+}
+#else
+static int hw_read(unsigned long long out[HW_COUNT]) {
+    (void)out;
+    return 0;
+}
+#endif
+
+void la_prof_begin(la_prof_scope *s) {
+    s->hw = hw_read(s->hw0);
+    s->bytes0 = la_prof_thread_bytes;
+    s->t0_ns = now_ns();
+}
+
+void la_prof_end(const la_prof_scope *s, la_prof_op op, unsigned long long flops) {
+    const unsigned long long t1 = now_ns();
+    prof_slot *slot = &g_slots[op];
+
+    atomic_fetch_add_explicit(&slot->calls, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&slot->time_ns, t1 - s->t0_ns, memory_order_relaxed);
+    atomic_fetch_add_explicit(&slot->flops, flops, memory_order_relaxed);
+    atomic_fetch_add_explicit(&slot->bytes_alloc, la_prof_thread_bytes - s->bytes0,
+                              memory_order_relaxed);
+
+    unsigned long long hw1[HW_COUNT];
+    if (s->hw && hw_read(hw1)) {
+        for (int i = 0; i < HW_COUNT; i++) {
+            atomic_fetch_add_explicit(&slot->hw[i], hw1[i] - s->hw0[i], memory_order_relaxed);
+        }
+    }
+}
+
+int la_prof_enabled(void) {
+    return 1;
+}
+
+int la_prof_hw_available(void) {
+    unsigned long long tmp[HW_COUNT];
+    return hw_read(tmp);
+}
+
+la_status la_prof_get(la_prof_op op, la_prof_stats *out) {
+    if (!out || (int)op < 0 || op >= LA_PROF_OP_COUNT) return LA_ERR_DIM;
+    prof_slot *slot = &g_slots[op];
+
+    out->calls = atomic_load_explicit(&slot->calls, memory_order_relaxed);
+    out->bytes_alloc = atomic_load_explicit(&slot->bytes_alloc, memory_order_relaxed);
+    out->time_ns = atomic_load_explicit(&slot->time_ns, memory_order_relaxed);
+    out->flops = atomic_load_explicit(&slot->flops, memory_order_relaxed);
+    out->cache_misses = atomic_load_explicit(&slot->hw[HW_CACHE_MISSES], memory_order_relaxed);
+    out->cycles = atomic_load_explicit(&slot->hw[HW_CYCLES], memory_order_relaxed);
+    out->instructions = atomic_load_explicit(&slot->hw[HW_INSTRUCTIONS], memory_order_relaxed);
+    return LA_OK;
+}
+
+void la_prof_reset(void) {
+    for (int op = 0; op < LA_PROF_OP_COUNT; op++) {
+        prof_slot *slot = &g_slots[op];
+        atomic_store(&slot->calls, 0);
+        atomic_store(&slot->bytes_alloc, 0);
+        atomic_store(&slot->time_ns, 0);
+        atomic_store(&slot->flops, 0);
+        for (int i = 0; i < HW_COUNT; i++) {
+            atomic_store(&slot->hw[i], 0);
+        }
+    }
+}
+
+#else  // !LA_PROFILE
+
+int la_prof_enabled(void) {
+    return 0;
+}
+
+int la_prof_hw_available(void) {
+    return 0;
+}
+
+la_status la_prof_get(la_prof_op op, la_prof_stats *out) {
+    if (!out || (int)op < 0 || op >= LA_PROF_OP_COUNT) return LA_ERR_DIM;
+    *out = (la_prof_stats){0};
+    return LA_OK;
+}
+
+void la_prof_reset(void) {
+}
+
+#endif
+
+const char *la_prof_op_name(la_prof_op op) {
+    static const char *const names[LA_PROF_OP_COUNT] = {
+        "la_add", "la_sub", "la_transpose", "la_mul", "la_det",
+        "la_solve", "la_inverse", "la_lu_factor", "la_lu_solve"
+    };
+    if ((int)op < 0 || op >= LA_PROF_OP_COUNT) return "unknown";
+    return names[op];
+}
+
+la_status la_prof_dump_json(FILE *fp) {
+    if (!fp) return LA_ERR_DIM;
+
+    fprintf(fp, "{\n  \"enabled\": %s,\n  \"hw_counters\": %s,\n  \"ops\": {",
+            la_prof_enabled() ? "true" : "false",
+            la_prof_hw_available() ? "true" : "false");
+
+    for (int op = 0; op < LA_PROF_OP_COUNT; op++) {
+        la_prof_stats s;
+        la_prof_get((la_prof_op)op, &s);
+
+        const double gflops = s.time_ns ? (double)s.flops / (double)s.time_ns : 0.0;
+        const double ipc = s.cycles ? (double)s.instructions / (double)s.cycles : 0.0;
+
+        fprintf(fp,
+                "%s\n    \"%s\": {\"calls\": %llu, \"bytes_alloc\": %llu, "
+                "\"time_ns\": %llu, \"flops\": %llu, \"gflops\": %.3f, "
+                "\"cache_misses\": %llu, \"cycles\": %llu, "
+                "\"instructions\": %llu, \"ipc\": %.3f}",
+                op ? "," : "", la_prof_op_name((la_prof_op)op),
+                s.calls, s.bytes_alloc, s.time_ns, s.flops, gflops,
+                s.cache_misses, s.cycles, s.instructions, ipc);
+    }
+
+    fprintf(fp, "\n  }\n}\n");
+    return ferror(fp) ? LA_ERR_IO : LA_OK;
+}
@@ -0,0 +1,36 @@
+#ifndef LA_PROF_INTERNAL_H
+#define LA_PROF_INTERNAL_H
+
+#include "la_prof.h"
+
+// Instrumentation hooks used inside libla. With LA_PROFILE undefined they
+// expand to nothing, so the hot paths are unchanged.
+
+#ifdef LA_PROFILE
+
+typedef struct {
+  unsigned long long t0_ns;
+  unsigned long long bytes0;
+  unsigned long long hw0[3];
+  int hw;
+} la_prof_scope;
+
+// Bytes allocated by libla on the calling thread since it started
+extern _Thread_local unsigned long long la_prof_thread_bytes;
+
+void la_prof_begin(la_prof_scope *s);
+void la_prof_end(const la_prof_scope *s, la_prof_op op, unsigned long long flops);
+
+#define LA_PROF_BEGIN(s) la_prof_scope s; la_prof_begin(&s)
+#define LA_PROF_END(s, op, flops) la_prof_end(&s, (op), (unsigned long long)(flops))
+#define LA_PROF_ALLOC(bytes) (la_prof_thread_bytes += (unsigned long long)(bytes))
+
+#else
+
+#define LA_PROF_BEGIN(s) ((void)0)
+#define LA_PROF_END(s, op, flops) ((void)0)
+#define LA_PROF_ALLOC(bytes) ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,281 @@
+#include "la_reduce.h"
+#include "la_blas_internal.h"
+#include "la_kernels.h"
+#include "la_matrix_internal.h"
+
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+
+// Fewest entries a partition should cover; the sweep is memory bound.
+static const size_t LA_REDUCE_TASK_ELEMS = (size_t)1 << 18;
+
+// Partitions are capped so their accumulators fit on the stack.
+#define LA_REDUCE_MAX_PARTS 64
+
+#define LA_STAT_COLS (LA_STAT_NORM1 | LA_STAT_COL_SUMS)
+
+// Running totals for one partition of rows; *_c carry the compensation.
+typedef struct {
+  double sum, sum_c;
+  double ssq, ssq_c;
+  double trace, trace_c;
+  double amax, min, max, norminf;
+} part_acc;
+
+typedef struct {
+  const Matrix *A;
+  unsigned which;
+  size_t parts;
+  part_acc *acc;
+  double *colacc;    // parts x 4 x cols: sum, its Kahan term, |a| sum, its term
+  double *row_sums;
+} reduce_ctx;
+
+// Kahan-adds row x into the column sums s and column |x| sums a. Every
+// column is independent, so the loop vectorises without reassociation.
+static void col_accumulate(size_t n, const double *restrict x, double *restrict s,
+                           double *restrict sc, double *restrict a, double *restrict ac) {
+    for (size_t j = 0; j < n; j++) {
+        const double y = x[j] - sc[j];
+        const double t = s[j] + y;
+        sc[j] = (t - s[j]) - y;
+        s[j] = t;
+
+        const double ya = fabs(x[j]) - ac[j];
+        const double ta = a[j] + ya;
+        ac[j] = (ta - a[j]) - ya;
+        a[j] = ta;
+    }
+}
+
+// Partitions [begin, end): partition p covers rows [rows*p/parts, rows*(p+1)/parts)
+static la_status reduce_parts(void *arg, size_t begin, size_t end) {
+    const reduce_ctx *c = (const reduce_ctx *)arg;
+    const Matrix *A = c->A;
+    const size_t n = A->cols;
+
+    for (size_t p = begin; p < end; p++) {
+        part_acc acc = {0};
+        acc.min = INFINITY;
+        acc.max = -INFINITY;
+
+        double *col = c->colacc ? c->colacc + p * 4 * n : NULL;
+        const size_t r0 = A->rows * p / c->parts;
+        const size_t r1 = A->rows * (p + 1) / c->parts;
+
+        for (size_t i = r0; i < r1; i++) {
+            const double *row = A->data + i * n;
+            la_kern_rstats r;
+            la_kern_row_stats(n, row, &r);
+
+            if (c->row_sums) c->row_sums[i] = r.sum;
+            acc.sum = la_kern_sum2(acc.sum, r.sum, &acc.sum_c);
+            acc.ssq = la_kern_sum2(acc.ssq, r.ssq, &acc.ssq_c);
+            if (r.asum > acc.norminf) acc.norminf = r.asum;
+            if (r.amax > acc.amax) acc.amax = r.amax;
+            if (r.min < acc.min) acc.min = r.min;
+            if (r.max > acc.max) acc.max = r.max;
+            if (c->which & LA_STAT_TRACE) {
+                acc.trace = la_kern_sum2(acc.trace, row[i], &acc.trace_c);
+            }
+            if (col) col_accumulate(n, row, col, col + n, col + 2 * n, col + 3 * n);
+        }
+        c->acc[p] = acc;
+    }
+    return LA_OK;
+}
+
+// Trace on its own reads just the diagonal, in any layout
+static double trace_diag(const Matrix *A) {
+    double s = 0.0, comp = 0.0;
+    for (size_t i = 0; i < A->rows; i++) {
+        s = la_kern_sum2(s, LA_REF(A, i, i), &comp);
+    }
+    return s + comp;
+}
+
+// Frobenius norm with every entry scaled by 1 / amax, for when the plain
+// sum of squares overflowed or lost precision to underflow.
+static double fro_scaled(const Matrix *A, double amax) {
+    const size_t count = A->rows * A->cols;
+    const double inv = 1.0 / amax;
+    double s = 0.0, comp = 0.0;
+    for (size_t k = 0; k < count; k++) {
+        const double v = A->data[k] * inv;
+        s = la_kern_sum2(s, v * v, &comp);
+    }
+    return amax * sqrt(s + comp);
+}
+
+// Column-major A is stored as row-major A^T: reduce that with the row and
+// column statistics swapped.
+static la_status reduce_col_major(la_stats *st, const Matrix *A, unsigned which) {
+    static const unsigned swapped = LA_STAT_NORM1 | LA_STAT_NORMINF |
+                                    LA_STAT_ROW_SUMS | LA_STAT_COL_SUMS;
+    unsigned w = which & ~swapped;
+    if (which & LA_STAT_NORM1) w |= LA_STAT_NORMINF;
+    if (which & LA_STAT_NORMINF) w |= LA_STAT_NORM1;
+    if (which & LA_STAT_ROW_SUMS) w |= LA_STAT_COL_SUMS;
+    if (which & LA_STAT_COL_SUMS) w |= LA_STAT_ROW_SUMS;
+
+    const Matrix At = la_matrix_storage_view(A);
+    la_stats t = *st;
+    t.row_sums = st->col_sums;
+    t.col_sums = st->row_sums;
+    la_status status = la_reduce(&t, &At, w);
+    if (status != LA_OK) return status;
+
+    const double norm1 = t.norminf, norminf = t.norm1;
+    t.row_sums = st->row_sums;
+    t.col_sums = st->col_sums;
+    t.norm1 = (which & LA_STAT_NORM1) ? norm1 : st->norm1;
+    t.norminf = (which & LA_STAT_NORMINF) ? norminf : st->norminf;
+    *st = t;
+    return LA_OK;
+}
+
+la_status la_reduce(la_stats *st, const Matrix *A, unsigned which) {
+    if (!st || !A || !A->data || A->rows == 0 || A->cols == 0) return LA_ERR_DIM;
+    if ((which & LA_STAT_TRACE) && A->rows != A->cols) return LA_ERR_DIM;
+    if ((which & LA_STAT_ROW_SUMS) && !st->row_sums) return LA_ERR_DIM;
+    if ((which & LA_STAT_COL_SUMS) && !st->col_sums) return LA_ERR_DIM;
+
+    if (which == LA_STAT_TRACE) {
+        st->trace = trace_diag(A);
+        return LA_OK;
+    }
+    if (A->layout == LA_COL_MAJOR) return reduce_col_major(st, A, which);
+    if (A->layout == LA_TILED) {
+        Matrix tmp = (Matrix){0};
+        const Matrix *R = NULL;
+        la_status status = la_matrix_row_major(A, &tmp, &R);
+        if (status == LA_OK) status = la_reduce(st, R, which);
+        la_matrix_free(&tmp);
+        return status;
+    }
+
+    // Deterministic mode fixes the partitions (and so the summation tree)
+    // from the size alone; otherwise there is one per thread at most
+    const size_t n = A->cols;
+    size_t parts = A->rows * n / LA_REDUCE_TASK_ELEMS;
+    const size_t threads = la_blas_threads();
+    if (!la_get_deterministic() && parts > threads) parts = threads;
+    if (parts > A->rows) parts = A->rows;
+    if (parts > LA_REDUCE_MAX_PARTS) parts = LA_REDUCE_MAX_PARTS;
+    if (parts == 0) parts = 1;
+
+    part_acc acc[LA_REDUCE_MAX_PARTS];
+    reduce_ctx c = {A, which, parts, acc, NULL,
+                    (which & LA_STAT_ROW_SUMS) ? st->row_sums : NULL};
+    if (which & LA_STAT_COLS) {
+        c.colacc = calloc(parts * 4 * n, sizeof(double));
+        if (!c.colacc) return LA_ERR_ALLOC;
+    }
+
+    la_status status = la_blas_parallel_for(parts, 1, reduce_parts, &c);
+    if (status != LA_OK) {
+        free(c.colacc);
+        return status;
+    }
+
+    // Partitions are combined in order, so the result does not depend on
+    // which thread ran which partition.
+    part_acc t = acc[0];
+    double sum = t.sum, sum_c = t.sum_c, ssq = t.ssq, ssq_c = t.ssq_c;
+    double trace = t.trace, trace_c = t.trace_c;
+    for (size_t p = 1; p < parts; p++) {
+        sum = la_kern_sum2(sum, acc[p].sum + acc[p].sum_c, &sum_c);
+        ssq = la_kern_sum2(ssq, acc[p].ssq + acc[p].ssq_c, &ssq_c);
+        trace = la_kern_sum2(trace, acc[p].trace + acc[p].trace_c, &trace_c);
+        if (acc[p].norminf > t.norminf) t.norminf = acc[p].norminf;
+        if (acc[p].amax > t.amax) t.amax = acc[p].amax;
+        if (acc[p].min < t.min) t.min = acc[p].min;
+        if (acc[p].max > t.max) t.max = acc[p].max;
+    }
+
+    if (which & LA_STAT_SUM) st->sum = sum + sum_c;
+    if (which & LA_STAT_TRACE) st->trace = trace + trace_c;
+    if (which & LA_STAT_NORMINF) st->norminf = t.norminf;
+    if (which & LA_STAT_MAXABS) st->maxabs = t.amax;
+    if (which & LA_STAT_MIN) st->min = t.min;
+    if (which & LA_STAT_MAX) st->max = t.max;
+    if (which & LA_STAT_FRO) {
+        ssq += ssq_c;
+        if (t.amax > 0.0 && (isinf(ssq) || ssq < DBL_MIN / DBL_EPSILON)) {
+            st->fro = fro_scaled(A, t.amax);
+        } else {
+            st->fro = sqrt(ssq);
+        }
+    }
+
+    if (c.colacc) {
+        double norm1 = 0.0;
+        for (size_t j = 0; j < n; j++) {
+            double s = 0.0, a = 0.0;
+            for (size_t p = 0; p < parts; p++) {
+                const double *col = c.colacc + p * 4 * n;
+                s += col[j] - col[n + j];
+                a += col[2 * n + j] - col[3 * n + j];
+            }
+            if (which & LA_STAT_COL_SUMS) st->col_sums[j] = s;
+            if (a > norm1) norm1 = a;
+        }
+        if (which & LA_STAT_NORM1) st->norm1 = norm1;
+        free(c.colacc);
+    }
+    return LA_OK;
+}
+
+// ---------------- Single statistics ----------------
+
+static la_status reduce_one(double *out, const Matrix *A, la_stat which) {
+    if (!out) return LA_ERR_DIM;
+    la_stats st = {0};
+    const la_status status = la_reduce(&st, A, which);
+    if (status != LA_OK) return status;
+
+    switch (which) {
+    case LA_STAT_FRO: *out = st.fro; break;
+    case LA_STAT_NORM1: *out = st.norm1; break;
+    case LA_STAT_NORMINF: *out = st.norminf; break;
+    case LA_STAT_MAXABS: *out = st.maxabs; break;
+    case LA_STAT_TRACE: *out = st.trace; break;
+    default: *out = st.sum; break;
+    }
+    return LA_OK;
+}
+
+la_status la_norm_fro(double *out, const Matrix *A) { return reduce_one(out, A, LA_STAT_FRO); }
+la_status la_norm_1(double *out, const Matrix *A) { return reduce_one(out, A, LA_STAT_NORM1); }
+la_status la_norm_inf(double *out, const Matrix *A) { return reduce_one(out, A, LA_STAT_NORMINF); }
+la_status la_max_abs(double *out, const Matrix *A) { return reduce_one(out, A, LA_STAT_MAXABS); }
+la_status la_trace(double *out, const Matrix *A) { return reduce_one(out, A, LA_STAT_TRACE); }
+
+la_status la_row_sums(Matrix *out, const Matrix *A) {
+    if (!out || !A || out->data != NULL) return LA_ERR_DIM;
+    if (!A->data) return LA_ERR_DIM;
+
+    la_status status = la_matrix_init(out, A->rows, 1);
+    if (status != LA_OK) return status;
+
+    la_stats st = {0};
+    st.row_sums = out->data;
+    status = la_reduce(&st, A, LA_STAT_ROW_SUMS);
+    if (status != LA_OK) la_matrix_free(out);
+    return status;
+}
+
+la_status la_col_sums(Matrix *out, const Matrix *A) {
+    if (!out || !A || out->data != NULL) return LA_ERR_DIM;
+    if (!A->data) return LA_ERR_DIM;
+
+    la_status status = la_matrix_init(out, 1, A->cols);
+    if (status != LA_OK) return status;
+
+    la_stats st = {0};
+    st.col_sums = out->data;
+    status = la_reduce(&st, A, LA_STAT_COL_SUMS);
+    if (status != LA_OK) la_matrix_free(out);
+    return status;
+}
@@ -1,9 +1,27 @@
 #include "la_solve.h"
-#include <math.h>   // fabs
+#include "la_blas.h"
+#include "la_cache.h"
+#include "la_kernels.h"
+#include "la_matrix_internal.h"
+#include "la_par.h"
+#include "la_reduce.h"
+#include "la_prof_internal.h"
+#include "la_solve_internal.h"
+#include "la_task.h"
+#include <float.h>  // DBL_EPSILON
+#include <math.h>   // fabs, log, INFINITY
+#include <stdlib.h> // malloc, free
 
 // Tolerance for treating a pivot as "effectively zero"
 static const double LA_EPS = 1e-12;
 
+// Maximum number of Hager/Higham iterations (LAPACK uses 5 as well)
+static const int LA_RCOND_ITERS = 5;
+
+// Order from which la_logdet uses the tiled task-graph LU; below it the
+// thread start-up costs more than the factorization
+static const size_t LA_LOGDET_PAR_MIN = 256;
+
 static void swap_rows(Matrix *m, size_t r1, size_t r2) {
     if (r1 == r2) return;
     for (size_t j = 0; j < m->cols; j++) {
@@ -14,8 +32,8 @@ static void swap_rows(Matrix *m, size_t r1, size_t r2) {
 }
 
 // Finds pivot row for column 'col' in rows [col..n-1] using partial pivoting.
-// Returns 1 if pivot found, 0 if column is effectively zero.
-static int find_pivot_row(const Matrix *A, size_t col, size_t *pivot_out) {
+// Returns 1 if pivot found, 0 if column is effectively zero (below tol).
+static int find_pivot_row(const Matrix *A, size_t col, double tol, size_t *pivot_out) {
     const size_t n = A->rows;
     size_t pivot = col;
     double best = fabs(LA_AT(A, col, col));
@@ -28,193 +46,573 @@ static int find_pivot_row(const Matrix *A, size_t col, size_t *pivot_out) {
         }
     }
 
-    if (best < LA_EPS) return 0;
+    if (best < tol) return 0;
     *pivot_out = pivot;
     return 1;
 }
 
-la_status la_det(double *det_out, const Matrix *A) {
-    if (!det_out || !A || !A->data) return LA_ERR_DIM;
-    if (A->rows != A->cols) return LA_ERR_DIM;
+// Column-major A: the pivot search and the trailing updates run down
+// contiguous columns (the LAPACK getf2 order) on a column-major copy, which
+// is then transposed into the row-major f->LU.
+static la_status lu_factor_cols(la_lu *f, const Matrix *A, double tol) {
+    const size_t n = A->rows;
 
-    Matrix M = (Matrix){0};
-    la_status st = la_matrix_copy(&M, A);
+    Matrix W = (Matrix){0};
+    la_status st = la_matrix_copy(&W, A);
     if (st != LA_OK) return st;
 
-    const size_t n = M.rows;
-    int sign = 1;
+    f->perm = (size_t *)malloc(n * sizeof(size_t));
+    if (!f->perm) {
+        la_matrix_free(&W);
+        return LA_ERR_ALLOC;
+    }
+    LA_PROF_ALLOC(n * sizeof(size_t));
+    for (size_t i = 0; i < n; i++) {
+        f->perm[i] = i;
+    }
 
     for (size_t col = 0; col < n; col++) {
+        double *c = W.data + col * n;
+
         size_t pivot_row = col;
+        double best = fabs(c[col]);
+        for (size_t r = col + 1; r < n; r++) {
+            if (fabs(c[r]) > best) {
+                best = fabs(c[r]);
+                pivot_row = r;
+            }
+        }
+        if (best < tol) {
+            la_matrix_free(&W);
+            la_lu_free(f);
+            return LA_ERR_SINGULAR;
+        }
 
-        if (!find_pivot_row(&M, col, &pivot_row)) {
-            la_matrix_free(&M);
-            *det_out = 0.0;
+        if (pivot_row != col) {
+            for (size_t j = 0; j < n; j++) {
+                double *w = W.data + j * n;
+                const double tmp = w[pivot_row];
+                w[pivot_row] = w[col];
+                w[col] = tmp;
+            }
+            size_t tmp = f->perm[pivot_row];
+            f->perm[pivot_row] = f->perm[col];
+            f->perm[col] = tmp;
+            f->sign = -f->sign;
+        }
+
+        const double pivot = c[col];
+        for (size_t r = col + 1; r < n; r++) {
+            c[r] /= pivot;
+        }
+        for (size_t j = col + 1; j < n; j++) {
+            double *w = W.data + j * n;
+            la_kern_axpy(n - col - 1, -w[col], c + col + 1, w + col + 1);
+        }
+    }
+
+    st = la_matrix_convert(&f->LU, &W, LA_ROW_MAJOR, 0);
+    la_matrix_free(&W);
+    if (st != LA_OK) la_lu_free(f);
+    return st;
+}
+
+// Factors a copy of A into f, treating pivots below the absolute tolerance
+// 'tol' as zero. f is left empty on failure.
+static la_status lu_factor_abs(la_lu *f, const Matrix *A, double tol) {
+    const size_t n = A->rows;
+
+    la_matrix_reset(&f->LU);
+    f->perm = NULL;
+    f->sign = 1;
+
+    if (A->layout == LA_COL_MAJOR) return lu_factor_cols(f, A, tol);
+    if (A->layout == LA_TILED) {
+        Matrix tmp = (Matrix){0};
+        const Matrix *R = NULL;
+        la_status st = la_matrix_row_major(A, &tmp, &R);
+        if (st == LA_OK) st = lu_factor_abs(f, R, tol);
+        la_matrix_free(&tmp);
+        return st;
+    }
+
+    la_status st = la_matrix_copy(&f->LU, A);
+    if (st != LA_OK) return st;
+
+    f->perm = (size_t *)malloc(n * sizeof(size_t));
+    if (!f->perm) {
+        la_lu_free(f);
+        return LA_ERR_ALLOC;
+    }
+    LA_PROF_ALLOC(n * sizeof(size_t));
+    for (size_t i = 0; i < n; i++) {
+        f->perm[i] = i;
+    }
+
+    Matrix *M = &f->LU;
+
+    for (size_t col = 0; col < n; col++) {
+        size_t pivot_row = col;
+
+        if (!find_pivot_row(M, col, tol, &pivot_row)) {
+            la_lu_free(f);
             return LA_ERR_SINGULAR;
         }
 
         if (pivot_row != col) {
-            swap_rows(&M, pivot_row, col);
-            sign = -sign;
+            swap_rows(M, pivot_row, col);
+            size_t tmp = f->perm[pivot_row];
+            f->perm[pivot_row] = f->perm[col];
+            f->perm[col] = tmp;
+            f->sign = -f->sign;
         }
 
-        const double pivot = LA_AT(&M, col, col);
+        const double pivot = LA_AT(M, col, col);
 
-        // Eliminate rows below pivot
+        // Eliminate rows below pivot, keeping the multipliers in L
         for (size_t r = col + 1; r < n; r++) {
-            const double factor = LA_AT(&M, r, col) / pivot;
-            LA_AT(&M, r, col) = 0.0; 
+            const double factor = LA_AT(M, r, col) / pivot;
+            LA_AT(M, r, col) = factor;
 
             for (size_t k = col + 1; k < n; k++) {
-                LA_AT(&M, r, k) -= factor * LA_AT(&M, col, k);
+                LA_AT(M, r, k) -= factor * LA_AT(M, col, k);
             }
         }
     }
+    return LA_OK;
+}
+
+la_status la_solve_factor(la_lu *f, const Matrix *A) {
+    return lu_factor_abs(f, A, LA_EPS);
+}
+
+// X = A^-1 B with la_solve's pivot tolerance, going through the installed
+// factorization cache when there is one.
+static la_status solve_factored(Matrix *X, const Matrix *A, const Matrix *B) {
+    la_factor_cache *cache = la_get_factor_cache();
+    if (cache) return la_cache_solve(cache, X, A, B);
+
+    la_lu f = {0};
+    la_status st = lu_factor_abs(&f, A, LA_EPS);
+    if (st != LA_OK) return st;
+
+    st = la_lu_solve(X, &f, B);
+    la_lu_free(&f);
+    return st;
+}
+
+// x = A^-1 b for a single vector (b and x must not alias)
+static void lu_solve_vec(const la_lu *f, const double *b, double *x) {
+    const size_t n = f->LU.rows;
+    Matrix xv;
+    la_matrix_wrap(&xv, n, 1, x, LA_ROW_MAJOR, 0);
 
-    double det = (double)sign;
     for (size_t i = 0; i < n; i++) {
-        det *= LA_AT(&M, i, i);
+        x[i] = b[f->perm[i]];
     }
-
-    la_matrix_free(&M);
-    *det_out = det;
-    return LA_OK;
+    la_trsv(LA_LOWER, LA_NO_TRANS, LA_UNIT, &f->LU, &xv);
+    la_trsv(LA_UPPER, LA_NO_TRANS, LA_NON_UNIT, &f->LU, &xv);
 }
 
-la_status la_solve(Matrix *x_out, const Matrix *A, const Matrix *b) {
-    if (!x_out || !A || !b || !A->data || !b->data) return LA_ERR_DIM; 
-    if (x_out->data != NULL) return LA_ERR_DIM;
+// z = A^-T c, where w holds c on entry and is used as scratch
+static void lu_solve_trans_vec(const la_lu *f, double *w, double *z) {
+    const size_t n = f->LU.rows;
+    Matrix wv;
+    la_matrix_wrap(&wv, n, 1, w, LA_ROW_MAJOR, 0);
 
-    la_matrix_reset(x_out); 
+    la_trsv(LA_UPPER, LA_TRANS, LA_NON_UNIT, &f->LU, &wv);
+    la_trsv(LA_LOWER, LA_TRANS, LA_UNIT, &f->LU, &wv);
 
-    if (A->rows != A->cols) return LA_ERR_DIM;   // A must be square
-    if (b->cols != 1) return LA_ERR_DIM;         // b must be a column vector
-    if (b->rows != A->rows) return LA_ERR_DIM;   // compatible sizes
+    // P z = u
+    for (size_t i = 0; i < n; i++) {
+        z[f->perm[i]] = w[i];
+    }
+}
 
-    const size_t n = A->rows;
+static double vec_norm1(const double *x, size_t n) {
+    double s = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        s += fabs(x[i]);
+    }
+    return s;
+}
 
-    // Build augmented matrix [A | b] of size n x (n+1)
-    Matrix Aug = (Matrix){0};
-    la_status st = la_matrix_init(&Aug, n, n + 1);
-    if (st != LA_OK) return st;
+// Normwise backward error of x as a solution of A x = b (b is n x 1)
+static double backward_error(const Matrix *A, const Matrix *x, const Matrix *b) {
+    const size_t n = A->rows;
+    double rnorm = 0.0;
+    double anorm = 0.0;
+    double xnorm = 0.0;
+    double bnorm = 0.0;
 
     for (size_t i = 0; i < n; i++) {
+        double r = LA_AT(b, i, 0);
+        double rowsum = 0.0;
         for (size_t j = 0; j < n; j++) {
-            LA_AT(&Aug, i, j) = LA_AT(A, i, j);
+            r -= LA_AT(A, i, j) * LA_AT(x, j, 0);
+            rowsum += fabs(LA_AT(A, i, j));
         }
-        LA_AT(&Aug, i, n) = LA_AT(b, i, 0);
+        if (fabs(r) > rnorm) rnorm = fabs(r);
+        if (rowsum > anorm) anorm = rowsum;
+        if (fabs(LA_AT(x, i, 0)) > xnorm) xnorm = fabs(LA_AT(x, i, 0));
+        if (fabs(LA_AT(b, i, 0)) > bnorm) bnorm = fabs(LA_AT(b, i, 0));
     }
 
-    // Forward elimination with partial pivoting
-    for (size_t col = 0; col < n; col++) {
-        size_t pivot_row = col;
-        double best = fabs(LA_AT(&Aug, col, col));
+    const double denom = anorm * xnorm + bnorm;
+    if (denom == 0.0) return 0.0;
+    return rnorm / denom;
+}
 
-        for (size_t r = col + 1; r < n; r++) {
-            double v = fabs(LA_AT(&Aug, r, col));
-            if (v > best) {
-                best = v;
-                pivot_row = r;
-            }
-        }
+la_status la_lu_factor(la_lu *f, const Matrix *A, const la_solve_opts *opts) {
+    if (!f || !A || !A->data) return LA_ERR_DIM;
+    if (A->rows != A->cols) return LA_ERR_DIM;
 
-        if (best < LA_EPS) {
-            la_matrix_free(&Aug);
-            return LA_ERR_SINGULAR;
-        }
+    la_matrix_reset(&f->LU);
+    f->perm = NULL;
 
-        if (pivot_row != col) {
-            swap_rows(&Aug, pivot_row, col);
-        }
+    LA_PROF_BEGIN(prof);
 
-        const double pivot = LA_AT(&Aug, col, col);
+    const size_t n = A->rows;
+    double maxabs = 0.0;
+    double norm1 = 0.0;
+    if (A->layout == LA_ROW_MAJOR) {
+        la_kern_norms(A->rows, A->cols, A->data, A->cols, &maxabs, &norm1);
+    } else {
+        la_stats s = {0};
+        la_status st = la_reduce(&s, A, LA_STAT_MAXABS | LA_STAT_NORM1);
+        if (st != LA_OK) return st;
+        maxabs = s.maxabs;
+        norm1 = s.norm1;
+    }
 
-        // Eliminate entries below pivot
-        for (size_t r = col + 1; r < n; r++) {
-            const double factor = LA_AT(&Aug, r, col) / pivot;
-            LA_AT(&Aug, r, col) = 0.0;
+    f->anorm = norm1;
+    if (maxabs == 0.0) return LA_ERR_SINGULAR;
 
-            for (size_t k = col + 1; k < n + 1; k++) {
-                LA_AT(&Aug, r, k) -= factor * LA_AT(&Aug, col, k);
-            }
+    double rel = (opts && opts->pivot_tol > 0.0) ? opts->pivot_tol
+                                                 : (double)n * DBL_EPSILON;
+
+    la_status st = lu_factor_abs(f, A, rel * maxabs);
+    if (st != LA_OK) return st;
+
+    LA_PROF_END(prof, LA_PROF_LU_FACTOR, 2 * n * n * n / 3);
+    return LA_OK;
+}
+
+la_status la_lu_solve(Matrix *X_out, const la_lu *f, const Matrix *B) {
+    if (!X_out || !f || !B || !f->LU.data || !f->perm || !B->data) return LA_ERR_DIM;
+    if (X_out->data != NULL) return LA_ERR_DIM;
+    if (B->rows != f->LU.rows) return LA_ERR_DIM;
+
+    LA_PROF_BEGIN(prof);
+
+    const Matrix *M = &f->LU;
+    const size_t n = M->rows;
+    const size_t k = B->cols;
+
+    la_status st = la_matrix_init(X_out, n, k);
+    if (st != LA_OK) return st;
+
+    // X = P B
+    for (size_t i = 0; i < n; i++) {
+        for (size_t c = 0; c < k; c++) {
+            LA_AT(X_out, i, c) = LA_REF(B, f->perm[i], c);
         }
     }
 
-    // Allocate solution vector x (n x 1)
-    st = la_matrix_init(x_out, n, 1);
+    // L Y = P B, then U X = Y
+    st = la_trsm(LA_LEFT, LA_LOWER, LA_NO_TRANS, LA_UNIT, 1.0, M, X_out);
+    if (st == LA_OK) st = la_trsm(LA_LEFT, LA_UPPER, LA_NO_TRANS, LA_NON_UNIT, 1.0, M, X_out);
     if (st != LA_OK) {
-        la_matrix_free(&Aug);
+        la_matrix_free(X_out);
         return st;
     }
+    LA_PROF_END(prof, LA_PROF_LU_SOLVE, 2 * n * n * k);
+    return LA_OK;
+}
 
-    // Back substitution 
-    for (size_t i = n; i-- > 0;) {
-        const double rhs = LA_AT(&Aug, i, n);
+la_status la_lu_rcond(double *rcond_out, const la_lu *f) {
+    if (!rcond_out || !f || !f->LU.data || !f->perm) return LA_ERR_DIM;
+
+    const size_t n = f->LU.rows;
+    *rcond_out = 0.0;
+    if (f->anorm == 0.0) return LA_OK;
+
+    double *x = (double *)malloc(n * sizeof(double));
+    double *y = (double *)malloc(n * sizeof(double));
+    double *z = (double *)malloc(n * sizeof(double));
+    if (!x || !y || !z) {
+        free(x);
+        free(y);
+        free(z);
+        return LA_ERR_ALLOC;
+    }
+    LA_PROF_ALLOC(3 * n * sizeof(double));
 
-        double sum = 0.0;
-        for (size_t j = i + 1; j < n; j++) {
-            sum += LA_AT(&Aug, i, j) * LA_AT(x_out, j, 0);
+    // Hager's method: maximise ||A^-1 x||_1 over the unit 1-norm ball,
+    // starting from the uniform vector and moving to the vertex e_j
+    // suggested by the subgradient z = A^-T sign(A^-1 x).
+    double est = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        x[i] = 1.0 / (double)n;
+    }
+
+    for (int iter = 0; iter < LA_RCOND_ITERS; iter++) {
+        lu_solve_vec(f, x, y);
+        const double e = vec_norm1(y, n);
+        if (iter > 0 && e <= est) break;
+        est = e;
+
+        for (size_t i = 0; i < n; i++) {
+            y[i] = (y[i] >= 0.0) ? 1.0 : -1.0;
         }
+        lu_solve_trans_vec(f, y, z);
 
-        const double diag = LA_AT(&Aug, i, i);
-        if (fabs(diag) < LA_EPS) {
-            la_matrix_free(&Aug);
-            la_matrix_free(x_out);
-            return LA_ERR_SINGULAR;
+        size_t jmax = 0;
+        double ztx = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            if (fabs(z[i]) > fabs(z[jmax])) jmax = i;
+            ztx += z[i] * x[i];
+        }
+        if (fabs(z[jmax]) <= ztx) break;
+
+        for (size_t i = 0; i < n; i++) {
+            x[i] = 0.0;
         }
+        x[jmax] = 1.0;
+    }
+
+    // Higham's safeguard against the (rare) cases where Hager underestimates
+    for (size_t i = 0; i < n; i++) {
+        double t = (n > 1) ? (double)i / (double)(n - 1) : 0.0;
+        x[i] = ((i % 2) ? -1.0 : 1.0) * (1.0 + t);
+    }
+    lu_solve_vec(f, x, y);
+    const double alt = 2.0 * vec_norm1(y, n) / (3.0 * (double)n);
+    if (alt > est) est = alt;
 
-        LA_AT(x_out, i, 0) = (rhs - sum) / diag;
+    free(x);
+    free(y);
+    free(z);
+
+    if (est > 0.0) {
+        *rcond_out = 1.0 / (f->anorm * est);
     }
+    return LA_OK;
+}
+
+void la_lu_free(la_lu *f) {
+    if (!f) return;
+    la_matrix_free(&f->LU);
+    free(f->perm);
+    f->perm = NULL;
+    f->sign = 1;
+}
 
-    la_matrix_free(&Aug);
+la_status la_lu_logdet(int *sign_out, double *logabs_out, const la_lu *f) {
+    if (!sign_out || !logabs_out || !f || !f->LU.data) return LA_ERR_DIM;
+
+    int sign = f->sign;
+    double logabs = 0.0;
+    for (size_t i = 0; i < f->LU.rows; i++) {
+        const double u = LA_AT(&f->LU, i, i);
+        if (u < 0.0) sign = -sign;
+        logabs += log(fabs(u));
+    }
+
+    *sign_out = sign;
+    *logabs_out = logabs;
     return LA_OK;
 }
 
-la_status la_inverse(Matrix *A_inv, const Matrix *A) {
-    if (!A_inv || !A || !A->data) return LA_ERR_DIM;
-    if (A_inv->data != NULL) return LA_ERR_DIM;
+la_status la_logdet(int *sign_out, double *logabs_out, const Matrix *A) {
+    if (!sign_out || !logabs_out || !A || !A->data) return LA_ERR_DIM;
     if (A->rows != A->cols) return LA_ERR_DIM;
 
-    const size_t n = A->rows;
+    la_lu f = {0};
+    la_status st = (A->rows < LA_LOGDET_PAR_MIN) ? la_lu_factor(&f, A, NULL)
+                                                 : la_par_lu_factor(&f, A, NULL);
+    if (st == LA_ERR_SINGULAR) {
+        *sign_out = 0;
+        *logabs_out = -INFINITY;
+    }
+    if (st != LA_OK) return st;
+
+    st = la_lu_logdet(sign_out, logabs_out, &f);
+    la_lu_free(&f);
+    return st;
+}
+
+typedef struct {
+  const Matrix *As;
+  int *signs;
+  double *logabs;
+  size_t i0, i1;  // matrices [i0, i1)
+} logdet_task;
+
+static la_status logdet_batch_task(void *arg) {
+    const logdet_task *t = (const logdet_task *)arg;
+    for (size_t i = t->i0; i < t->i1; i++) {
+        la_lu f = {0};
+        la_status st = la_lu_factor(&f, &t->As[i], NULL);
+        if (st == LA_ERR_SINGULAR) {
+            t->signs[i] = 0;
+            t->logabs[i] = -INFINITY;
+            continue;
+        }
+        if (st != LA_OK) return st;
+
+        la_lu_logdet(&t->signs[i], &t->logabs[i], &f);
+        la_lu_free(&f);
+    }
+    return LA_OK;
+}
+
+la_status la_logdet_batch(int *signs, double *logabs, const Matrix *As, size_t count,
+                          size_t nthreads) {
+    if (!signs || !logabs || (!As && count > 0)) return LA_ERR_DIM;
+    for (size_t i = 0; i < count; i++) {
+        if (!As[i].data || As[i].rows != As[i].cols) return LA_ERR_DIM;
+    }
+    if (count == 0) return LA_OK;
+
+    // Small matrices: contiguous chunks of whole factorizations per task
+    const size_t threads = la_task_threads(nthreads);
+    const size_t ntasks = (count < 4 * threads) ? count : 4 * threads;
 
-    // Allocate output inverse matrix
-    la_status st = la_matrix_init(A_inv, n, n);
+    la_graph *g = la_graph_create(0, threads);
+    if (!g) return LA_ERR_ALLOC;
+
+    la_status st = LA_OK;
+    for (size_t t = 0; t < ntasks && st == LA_OK; t++) {
+        logdet_task lt = {As, signs, logabs, count * t / ntasks, count * (t + 1) / ntasks};
+        st = la_graph_submit(g, logdet_batch_task, &lt, sizeof(lt), 0, NULL, 0);
+    }
+    if (st == LA_OK) st = la_graph_run(g);
+    la_graph_destroy(g);
     if (st != LA_OK) return st;
 
-    // Temporary vectors
-    Matrix e = (Matrix){0};
-    Matrix x = (Matrix){0};
+    for (size_t i = 0; i < count; i++) {
+        if (signs[i] == 0) return LA_ERR_SINGULAR;
+    }
+    return LA_OK;
+}
 
-    st = la_matrix_init(&e, n, 1);
-    if (st != LA_OK) goto fail;
+la_status la_det(double *det_out, const Matrix *A) {
+    if (!det_out || !A || !A->data) return LA_ERR_DIM;
+    if (A->rows != A->cols) return LA_ERR_DIM;
 
-    // Solve A x = e_i for each column i
-    for (size_t col = 0; col < n; col++) {
-        // Reset e to zero
-        for (size_t i = 0; i < n; i++) {
-            LA_AT(&e, i, 0) = 0.0;
+    LA_PROF_BEGIN(prof);
+
+    la_factor_cache *cache = la_get_factor_cache();
+    if (cache) {
+        la_status st = la_cache_det(cache, det_out, A);
+        if (st != LA_OK) return st;
+    } else {
+        la_lu f = {0};
+        la_status st = lu_factor_abs(&f, A, LA_EPS);
+        if (st == LA_ERR_SINGULAR) {
+            *det_out = 0.0;
+            return LA_ERR_SINGULAR;
         }
-        LA_AT(&e, col, 0) = 1.0;
+        if (st != LA_OK) return st;
 
-        la_matrix_reset(&x);
+        double det = (double)f.sign;
+        for (size_t i = 0; i < f.LU.rows; i++) {
+            det *= LA_AT(&f.LU, i, i);
+        }
 
-        st = la_solve(&x, A, &e);
-        if (st != LA_OK) goto fail;
+        la_lu_free(&f);
+        *det_out = det;
+    }
+    LA_PROF_END(prof, LA_PROF_DET, 2 * A->rows * A->rows * A->rows / 3);
+    return LA_OK;
+}
 
-        // Copy solution into column col of A_inv
-        for (size_t i = 0; i < n; i++) {
-            LA_AT(A_inv, i, col) = LA_AT(&x, i, 0);
-        }
+la_status la_solve(Matrix *x_out, const Matrix *A, const Matrix *b) {
+    if (!x_out || !A || !b || !A->data || !b->data) return LA_ERR_DIM; 
+    if (x_out->data != NULL) return LA_ERR_DIM;
+
+    la_matrix_reset(x_out); 
 
-        la_matrix_free(&x);
+    if (A->rows != A->cols) return LA_ERR_DIM;   // A must be square
+    if (b->cols != 1) return LA_ERR_DIM;         // b must be a column vector
+    if (b->rows != A->rows) return LA_ERR_DIM;   // compatible sizes
+
+    LA_PROF_BEGIN(prof);
+
+    la_status st = solve_factored(x_out, A, b);
+    if (st == LA_OK) {
+        LA_PROF_END(prof, LA_PROF_SOLVE,
+                    2 * A->rows * A->rows * A->rows / 3 + 2 * A->rows * A->rows);
     }
+    return st;
+}
 
-    la_matrix_free(&e);
-    return LA_OK;
+la_status la_solve_ex(Matrix *x_out, const Matrix *A, const Matrix *b,
+                      const la_solve_opts *opts, la_solve_info *info) {
+    if (!x_out || !A || !b || !A->data || !b->data) return LA_ERR_DIM;
+    if (x_out->data != NULL) return LA_ERR_DIM;
+
+    la_matrix_reset(x_out);
 
-fail:
-    la_matrix_free(&e);
-    la_matrix_free(&x);
-    la_matrix_free(A_inv);
+    if (A->rows != A->cols) return LA_ERR_DIM;
+    if (b->cols != 1) return LA_ERR_DIM;
+    if (b->rows != A->rows) return LA_ERR_DIM;
+
+    if (info) {
+        info->rcond = 0.0;
+        info->berr = 0.0;
+        info->anorm = 0.0;
+    }
+
+    la_lu f = {0};
+    la_status st = la_lu_factor(&f, A, opts);
+    if (info) info->anorm = f.anorm;
+    if (st != LA_OK) return st;
+
+    st = la_lu_solve(x_out, &f, b);
+    if (st == LA_OK && info) {
+        st = la_lu_rcond(&info->rcond, &f);
+        Matrix tA = (Matrix){0}, tb = (Matrix){0};
+        const Matrix *rA = NULL, *rb = NULL;
+        if (st == LA_OK) st = la_matrix_row_major(A, &tA, &rA);
+        if (st == LA_OK) st = la_matrix_row_major(b, &tb, &rb);
+        if (st != LA_OK) {
+            la_matrix_free(x_out);
+        } else {
+            info->berr = backward_error(rA, x_out, rb);
+        }
+        la_matrix_free(&tA);
+        la_matrix_free(&tb);
+    }
+
+    la_lu_free(&f);
     return st;
 }
+
+la_status la_inverse(Matrix *A_inv, const Matrix *A) {
+    if (!A_inv || !A || !A->data) return LA_ERR_DIM;
+    if (A_inv->data != NULL) return LA_ERR_DIM;
+    if (A->rows != A->cols) return LA_ERR_DIM;
+
+    LA_PROF_BEGIN(prof);
+
+    const size_t n = A->rows;
+
+    // Factor once and solve A X = I for all columns together
+    Matrix I = (Matrix){0};
+    la_status st = la_matrix_init(&I, n, n);
+    if (st != LA_OK) return st;
+
+    la_matrix_fill(&I, 0.0);
+    for (size_t i = 0; i < n; i++) {
+        LA_AT(&I, i, i) = 1.0;
+    }
+
+    st = solve_factored(A_inv, A, &I);
+    la_matrix_free(&I);
+    if (st != LA_OK) return st;
+
+    LA_PROF_END(prof, LA_PROF_INVERSE, 2 * n * n * n);
+    return LA_OK;
+}
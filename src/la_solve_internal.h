@@ -0,0 +1,10 @@
+#ifndef LA_SOLVE_INTERNAL_H
+#define LA_SOLVE_INTERNAL_H
+
+#include "la_solve.h"
+
+// Factors A exactly as la_solve / la_det / la_inverse do (absolute pivot
+// tolerance), so cached factors give the same answers as uncached ones.
+la_status la_solve_factor(la_lu *f, const Matrix *A);
+
+#endif
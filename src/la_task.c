@@ -0,0 +1,268 @@
+#define _POSIX_C_SOURCE 200809L  // sysconf
+#include "la_task.h"
+
+#include <pthread.h>
+#include <stdint.h>  // SIZE_MAX
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define NO_TASK SIZE_MAX
+
+typedef struct {
+  la_task_fn fn;
+  void *arg;
+  int priority;
+  size_t npred;  // unfinished predecessors
+  size_t *succ;
+  size_t nsucc, capsucc;
+} task;
+
+typedef struct {
+  size_t writer;   // last task writing the handle
+  size_t *readers; // tasks reading it since that write
+  size_t nreaders, capreaders;
+} handle_state;
+
+struct la_graph {
+  task *tasks;
+  size_t ntasks, captasks;
+
+  handle_state *handles;
+  size_t nhandles;
+  size_t nthreads;
+
+  // Execution state
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+  size_t *heap;  // ready tasks, max-heap on (priority, -index)
+  size_t nheap;
+  size_t remaining;
+  la_status status;
+};
+
+size_t la_task_threads(size_t requested) {
+    if (requested > 0) return requested;
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (size_t)n : 1;
+}
+
+static int push_index(size_t **arr, size_t *len, size_t *cap, size_t v) {
+    if (*len == *cap) {
+        size_t ncap = *cap ? *cap * 2 : 4;
+        size_t *p = (size_t *)realloc(*arr, ncap * sizeof(size_t));
+        if (!p) return 0;
+        *arr = p;
+        *cap = ncap;
+    }
+    (*arr)[(*len)++] = v;
+    return 1;
+}
+
+static int add_edge(la_graph *g, size_t from, size_t to) {
+    if (from == NO_TASK || from == to) return 1;
+    task *t = &g->tasks[from];
+    if (t->nsucc > 0 && t->succ[t->nsucc - 1] == to) return 1;  // already linked
+    if (!push_index(&t->succ, &t->nsucc, &t->capsucc, to)) return 0;
+    g->tasks[to].npred++;
+    return 1;
+}
+
+la_graph *la_graph_create(size_t nhandles, size_t nthreads) {
+    la_graph *g = (la_graph *)calloc(1, sizeof(*g));
+    if (!g) return NULL;
+
+    g->handles = (handle_state *)calloc(nhandles ? nhandles : 1, sizeof(handle_state));
+    if (!g->handles) {
+        free(g);
+        return NULL;
+    }
+    for (size_t h = 0; h < nhandles; h++) {
+        g->handles[h].writer = NO_TASK;
+    }
+    g->nhandles = nhandles;
+    g->nthreads = la_task_threads(nthreads);
+    return g;
+}
+
+la_status la_graph_submit(la_graph *g, la_task_fn fn, const void *arg, size_t arg_size,
+                          int priority, const la_access *acc, size_t nacc) {
+    if (!g || !fn) return LA_ERR_DIM;
+    for (size_t a = 0; a < nacc; a++) {
+        if (acc[a].handle >= g->nhandles) return LA_ERR_DIM;
+    }
+
+    if (g->ntasks == g->captasks) {
+        size_t ncap = g->captasks ? g->captasks * 2 : 64;
+        task *p = (task *)realloc(g->tasks, ncap * sizeof(task));
+        if (!p) return LA_ERR_ALLOC;
+        g->tasks = p;
+        g->captasks = ncap;
+    }
+
+    const size_t id = g->ntasks;
+    task *t = &g->tasks[id];
+    memset(t, 0, sizeof(*t));
+    t->fn = fn;
+    t->priority = priority;
+    if (arg_size > 0) {
+        t->arg = malloc(arg_size);
+        if (!t->arg) return LA_ERR_ALLOC;
+        memcpy(t->arg, arg, arg_size);
+    }
+    g->ntasks++;
+
+    for (size_t a = 0; a < nacc; a++) {
+        handle_state *h = &g->handles[acc[a].handle];
+
+        if (!add_edge(g, h->writer, id)) return LA_ERR_ALLOC;
+        if (acc[a].write) {
+            for (size_t r = 0; r < h->nreaders; r++) {
+                if (!add_edge(g, h->readers[r], id)) return LA_ERR_ALLOC;
+            }
+            h->nreaders = 0;
+            h->writer = id;
+        } else if (!push_index(&h->readers, &h->nreaders, &h->capreaders, id)) {
+            return LA_ERR_ALLOC;
+        }
+    }
+    return LA_OK;
+}
+
+// ---------------- Ready heap ----------------
+
+static int heap_before(const la_graph *g, size_t a, size_t b) {
+    const int pa = g->tasks[a].priority;
+    const int pb = g->tasks[b].priority;
+    if (pa != pb) return pa > pb;
+    return a < b;  // FIFO among equal priorities
+}
+
+static void heap_push(la_graph *g, size_t id) {
+    size_t i = g->nheap++;
+    g->heap[i] = id;
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (!heap_before(g, g->heap[i], g->heap[parent])) break;
+        size_t tmp = g->heap[i];
+        g->heap[i] = g->heap[parent];
+        g->heap[parent] = tmp;
+        i = parent;
+    }
+}
+
+static size_t heap_pop(la_graph *g) {
+    size_t top = g->heap[0];
+    g->heap[0] = g->heap[--g->nheap];
+
+    size_t i = 0;
+    for (;;) {
+        size_t l = 2 * i + 1, r = l + 1, best = i;
+        if (l < g->nheap && heap_before(g, g->heap[l], g->heap[best])) best = l;
+        if (r < g->nheap && heap_before(g, g->heap[r], g->heap[best])) best = r;
+        if (best == i) break;
+        size_t tmp = g->heap[i];
+        g->heap[i] = g->heap[best];
+        g->heap[best] = tmp;
+        i = best;
+    }
+    return top;
+}
+
+// ---------------- Execution ----------------
+
+static void *worker_main(void *arg) {
+    la_graph *g = (la_graph *)arg;
+
+    pthread_mutex_lock(&g->lock);
+    for (;;) {
+        while (g->nheap == 0 && g->remaining > 0) {
+            pthread_cond_wait(&g->cond, &g->lock);
+        }
+        if (g->remaining == 0) break;
+
+        const size_t id = heap_pop(g);
+        const int skip = (g->status != LA_OK);
+        pthread_mutex_unlock(&g->lock);
+
+        la_status st = skip ? LA_OK : g->tasks[id].fn(g->tasks[id].arg);
+
+        pthread_mutex_lock(&g->lock);
+        if (st != LA_OK && g->status == LA_OK) g->status = st;
+
+        task *t = &g->tasks[id];
+        size_t woken = 0;
+        for (size_t s = 0; s < t->nsucc; s++) {
+            if (--g->tasks[t->succ[s]].npred == 0) {
+                heap_push(g, t->succ[s]);
+                woken++;
+            }
+        }
+        g->remaining--;
+        if (g->remaining == 0 || woken > 1) {
+            pthread_cond_broadcast(&g->cond);
+        } else if (woken == 1) {
+            pthread_cond_signal(&g->cond);
+        }
+    }
+    pthread_mutex_unlock(&g->lock);
+    return NULL;
+}
+
+la_status la_graph_run(la_graph *g) {
+    if (!g) return LA_ERR_DIM;
+    if (g->ntasks == 0) return LA_OK;
+
+    g->heap = (size_t *)malloc(g->ntasks * sizeof(size_t));
+    if (!g->heap) return LA_ERR_ALLOC;
+
+    g->nheap = 0;
+    g->remaining = g->ntasks;
+    g->status = LA_OK;
+    for (size_t id = 0; id < g->ntasks; id++) {
+        if (g->tasks[id].npred == 0) heap_push(g, id);
+    }
+
+    pthread_mutex_init(&g->lock, NULL);
+    pthread_cond_init(&g->cond, NULL);
+
+    // The calling thread is one of the workers
+    size_t extra = g->nthreads - 1;
+    if (extra > g->ntasks) extra = g->ntasks;
+
+    pthread_t *threads = NULL;
+    size_t started = 0;
+    if (extra > 0) {
+        threads = (pthread_t *)malloc(extra * sizeof(pthread_t));
+        for (; threads && started < extra; started++) {
+            if (pthread_create(&threads[started], NULL, worker_main, g) != 0) break;
+        }
+    }
+
+    worker_main(g);
+
+    for (size_t i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    free(threads);
+
+    pthread_cond_destroy(&g->cond);
+    pthread_mutex_destroy(&g->lock);
+    free(g->heap);
+    g->heap = NULL;
+    return g->status;
+}
+
+void la_graph_destroy(la_graph *g) {
+    if (!g) return;
+    for (size_t id = 0; id < g->ntasks; id++) {
+        free(g->tasks[id].arg);
+        free(g->tasks[id].succ);
+    }
+    for (size_t h = 0; h < g->nhandles; h++) {
+        free(g->handles[h].readers);
+    }
+    free(g->tasks);
+    free(g->handles);
+    free(g);
+}
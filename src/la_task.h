@@ -0,0 +1,41 @@
+#ifndef LA_TASK_H
+#define LA_TASK_H
+
+#include <stddef.h>  // size_t
+
+#include "la_matrix.h"
+
+// Internal task-graph runtime.
+//
+// Tasks are submitted in sequential program order together with the data
+// handles (e.g. tile indices) they read or write. Dependencies are inferred
+// from those accesses (read-after-write, write-after-read, write-after-write)
+// and the graph is then executed by a pool of threads, always running the
+// ready task with the highest priority first.
+
+typedef struct la_graph la_graph;
+
+typedef la_status (*la_task_fn)(void *arg);
+
+typedef struct {
+  size_t handle;
+  int write;  // 0 = read only, 1 = read/write
+} la_access;
+
+// nhandles: number of distinct data handles; nthreads: 0 = online CPUs.
+la_graph *la_graph_create(size_t nhandles, size_t nthreads);
+
+// Copies arg_size bytes of arg into the task. Larger priority runs first.
+la_status la_graph_submit(la_graph *g, la_task_fn fn, const void *arg, size_t arg_size,
+                          int priority, const la_access *acc, size_t nacc);
+
+// Runs every submitted task and returns the first non-LA_OK status a task
+// reported (remaining tasks are then skipped).
+la_status la_graph_run(la_graph *g);
+
+void la_graph_destroy(la_graph *g);
+
+// Number of worker threads for a requested count (0 = online CPUs)
+size_t la_task_threads(size_t requested);
+
+#endif
@@ -0,0 +1,231 @@
+#include "la_update.h"
+#include "la_matrix_internal.h"
+#include "la_ops.h"
+
+#include <math.h>    // sqrt
+#include <stdlib.h>  // malloc, free
+
+// C = I + V^T W (k x k), the Woodbury capacitance matrix
+static la_status capacitance(Matrix *C, const Matrix *V, const Matrix *W) {
+    const size_t n = V->rows;
+    const size_t k = V->cols;
+
+    la_status st = la_matrix_init(C, k, k);
+    if (st != LA_OK) return st;
+    la_matrix_fill(C, 0.0);
+
+    for (size_t i = 0; i < n; i++) {
+        for (size_t a = 0; a < k; a++) {
+            const double v = LA_AT(V, i, a);
+            for (size_t b = 0; b < k; b++) {
+                LA_AT(C, a, b) += v * LA_AT(W, i, b);
+            }
+        }
+    }
+    for (size_t a = 0; a < k; a++) {
+        LA_AT(C, a, a) += 1.0;
+    }
+    return LA_OK;
+}
+
+// T = V^T Y (k x m)
+static la_status mul_transposed(Matrix *T, const Matrix *V, const Matrix *Y) {
+    la_status st = la_matrix_init(T, V->cols, Y->cols);
+    if (st != LA_OK) return st;
+    la_matrix_fill(T, 0.0);
+
+    for (size_t i = 0; i < V->rows; i++) {
+        for (size_t a = 0; a < V->cols; a++) {
+            const double v = LA_AT(V, i, a);
+            for (size_t j = 0; j < Y->cols; j++) {
+                LA_AT(T, a, j) += v * LA_AT(Y, i, j);
+            }
+        }
+    }
+    return LA_OK;
+}
+
+// Y -= W S
+static void sub_product(Matrix *Y, const Matrix *W, const Matrix *S) {
+    for (size_t i = 0; i < Y->rows; i++) {
+        for (size_t a = 0; a < W->cols; a++) {
+            const double w = LA_AT(W, i, a);
+            for (size_t j = 0; j < Y->cols; j++) {
+                LA_AT(Y, i, j) -= w * LA_AT(S, a, j);
+            }
+        }
+    }
+}
+
+static int lowrank_dims_ok(size_t n, const Matrix *U, const Matrix *V) {
+    if (!U || !V || !U->data || !V->data) return 0;
+    return U->rows == n && V->rows == n && U->cols == V->cols;
+}
+
+static int row_major(const Matrix *m) {
+    return m->layout == LA_ROW_MAJOR;
+}
+
+la_status la_inverse_update(Matrix *A_inv, const Matrix *U, const Matrix *V) {
+    if (!A_inv || !A_inv->data) return LA_ERR_DIM;
+    if (A_inv->rows != A_inv->cols) return LA_ERR_DIM;
+    if (!lowrank_dims_ok(A_inv->rows, U, V)) return LA_ERR_DIM;
+
+    if (!row_major(A_inv) || !row_major(U) || !row_major(V)) {
+        Matrix ta = (Matrix){0}, tu = (Matrix){0}, tv = (Matrix){0};
+        Matrix *ra = NULL;
+        const Matrix *ru = NULL, *rv = NULL;
+        la_status st = la_matrix_row_major_inout(A_inv, &ta, &ra);
+        if (st == LA_OK) st = la_matrix_row_major(U, &tu, &ru);
+        if (st == LA_OK) st = la_matrix_row_major(V, &tv, &rv);
+        if (st == LA_OK) st = la_inverse_update(ra, ru, rv);
+        la_matrix_free(&tv);
+        la_matrix_free(&tu);
+        la_matrix_commit(A_inv, &ta);
+        return st;
+    }
+
+    Matrix W = (Matrix){0};   // A^-1 U
+    Matrix Z = (Matrix){0};   // V^T A^-1
+    Matrix Vt = (Matrix){0};
+    Matrix C = (Matrix){0};
+    Matrix S = (Matrix){0};   // C^-1 Z
+    la_lu fc = {0};
+
+    la_status st = la_mul(&W, A_inv, U);
+    if (st == LA_OK) st = la_transpose(&Vt, V);
+    if (st == LA_OK) st = la_mul(&Z, &Vt, A_inv);
+    if (st == LA_OK) st = capacitance(&C, V, &W);
+    if (st == LA_OK) st = la_lu_factor(&fc, &C, NULL);
+    if (st == LA_OK) st = la_lu_solve(&S, &fc, &Z);
+
+    // A^-1 - A^-1 U C^-1 V^T A^-1
+    if (st == LA_OK) sub_product(A_inv, &W, &S);
+
+    la_lu_free(&fc);
+    la_matrix_free(&S);
+    la_matrix_free(&C);
+    la_matrix_free(&Vt);
+    la_matrix_free(&Z);
+    la_matrix_free(&W);
+    return st;
+}
+
+la_status la_lu_solve_update(Matrix *X_out, const la_lu *f, const Matrix *U,
+                             const Matrix *V, const Matrix *B) {
+    if (!X_out || !f || !f->LU.data || !B || !B->data) return LA_ERR_DIM;
+    if (X_out->data != NULL) return LA_ERR_DIM;
+    if (B->rows != f->LU.rows) return LA_ERR_DIM;
+    if (!lowrank_dims_ok(f->LU.rows, U, V)) return LA_ERR_DIM;
+
+    if (!row_major(U) || !row_major(V)) {
+        Matrix tu = (Matrix){0}, tv = (Matrix){0};
+        const Matrix *ru = NULL, *rv = NULL;
+        la_status st = la_matrix_row_major(U, &tu, &ru);
+        if (st == LA_OK) st = la_matrix_row_major(V, &tv, &rv);
+        if (st == LA_OK) st = la_lu_solve_update(X_out, f, ru, rv, B);
+        la_matrix_free(&tv);
+        la_matrix_free(&tu);
+        return st;
+    }
+
+    Matrix W = (Matrix){0};   // A^-1 U
+    Matrix C = (Matrix){0};
+    Matrix T = (Matrix){0};   // V^T A^-1 B
+    Matrix S = (Matrix){0};   // C^-1 T
+    la_lu fc = {0};
+
+    la_status st = la_lu_solve(X_out, f, B);
+    if (st == LA_OK) st = la_lu_solve(&W, f, U);
+    if (st == LA_OK) st = capacitance(&C, V, &W);
+    if (st == LA_OK) st = mul_transposed(&T, V, X_out);
+    if (st == LA_OK) st = la_lu_factor(&fc, &C, NULL);
+    if (st == LA_OK) st = la_lu_solve(&S, &fc, &T);
+
+    if (st == LA_OK) {
+        sub_product(X_out, &W, &S);
+    } else {
+        la_matrix_free(X_out);
+    }
+
+    la_lu_free(&fc);
+    la_matrix_free(&S);
+    la_matrix_free(&T);
+    la_matrix_free(&C);
+    la_matrix_free(&W);
+    return st;
+}
+
+// One hyperbolic/Givens sweep: L L^T + sign * x x^T. x is destroyed.
+static int chol_rank1(Matrix *L, double *x, double sign) {
+    const size_t n = L->rows;
+
+    for (size_t k = 0; k < n; k++) {
+        const double lkk = LA_AT(L, k, k);
+        const double r2 = lkk * lkk + sign * x[k] * x[k];
+        if (!(r2 > 0.0) || lkk == 0.0) return 0;
+
+        const double r = sqrt(r2);
+        const double c = r / lkk;
+        const double s = x[k] / lkk;
+        LA_AT(L, k, k) = r;
+
+        for (size_t i = k + 1; i < n; i++) {
+            const double lik = (LA_AT(L, i, k) + sign * s * x[i]) / c;
+            LA_AT(L, i, k) = lik;
+            x[i] = c * x[i] - s * lik;
+        }
+    }
+    return 1;
+}
+
+la_status la_cholesky_update(Matrix *L, const Matrix *X, int sign) {
+    if (!L || !L->data || !X || !X->data) return LA_ERR_DIM;
+    if (L->rows != L->cols || X->rows != L->rows) return LA_ERR_DIM;
+    if (sign != 1 && sign != -1) return LA_ERR_DIM;
+
+    if (!row_major(L) || !row_major(X)) {
+        Matrix tl = (Matrix){0}, tx = (Matrix){0};
+        Matrix *rl = NULL;
+        const Matrix *rx = NULL;
+        la_status st = la_matrix_row_major_inout(L, &tl, &rl);
+        if (st == LA_OK) st = la_matrix_row_major(X, &tx, &rx);
+        if (st == LA_OK) st = la_cholesky_update(rl, rx, sign);
+        la_matrix_free(&tx);
+        la_matrix_commit(L, &tl);
+        return st;
+    }
+
+    const size_t n = L->rows;
+
+    // A downdate can fail half way; keep the original to roll back
+    Matrix backup = (Matrix){0};
+    if (sign < 0) {
+        la_status st = la_matrix_copy(&backup, L);
+        if (st != LA_OK) return st;
+    }
+
+    double *x = (double *)malloc(n * sizeof(double));
+    if (!x) {
+        la_matrix_free(&backup);
+        return LA_ERR_ALLOC;
+    }
+
+    la_status st = LA_OK;
+    for (size_t col = 0; col < X->cols && st == LA_OK; col++) {
+        for (size_t i = 0; i < n; i++) {
+            x[i] = LA_AT(X, i, col);
+        }
+        if (!chol_rank1(L, x, (double)sign)) st = LA_ERR_SINGULAR;
+    }
+
+    if (st != LA_OK && backup.data) {
+        for (size_t i = 0; i < n * n; i++) {
+            L->data[i] = backup.data[i];
+        }
+    }
+
+    free(x);
+    la_matrix_free(&backup);
+    return st;
+}
@@ -0,0 +1,376 @@
+// Performance regression test: times fixed workloads for each kernel,
+// compares their throughput with a stored baseline and checks residuals
+// of large random systems.
+//
+//   perf_la <baseline> [--tolerance f] [--update]
+//   perf_la --accuracy-only
+//
+// A kernel fails when its throughput falls below (1 - f) times the
+// baseline. f is --tolerance if given, else LA_PERF_TOLERANCE from the
+// environment, else the LA_PERF_TOLERANCE CMake setting (default 0.5).
+// A kernel with no baseline entry also fails; --update rewrites the
+// baseline with the measured values instead of comparing.
+// --accuracy-only skips the timing and only checks the residuals; it does
+// not depend on the machine, so CTest always runs it.
+
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "la_blas.h"
+#include "la_elem.h"
+#include "la_matrix.h"
+#include "la_ops.h"
+#include "la_par.h"
+#include "la_reduce.h"
+#include "la_solve.h"
+
+// Timed samples per workload; the fastest counts
+static const int PERF_REPS = 3;
+
+// Each sample repeats the workload for at least this long
+static const double PERF_MIN_SECONDS = 0.2;
+
+#ifndef LA_PERF_DEFAULT_TOLERANCE
+#define LA_PERF_DEFAULT_TOLERANCE 0.5
+#endif
+
+#define PERF_MAX_CASES 32
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+static void fill_random(Matrix *m, unsigned *seed) {
+    for (size_t k = 0; k < m->rows * m->cols; k++) {
+        *seed = *seed * 1103515245u + 12345u;
+        m->data[k] = (double)(*seed >> 8) / 16777216.0 - 0.5;
+    }
+}
+
+// ---------------- Workloads ----------------
+
+// Inputs shared by the workloads, built once
+typedef struct {
+  Matrix A;    // n x n, diagonally dominant
+  Matrix B;    // n x n
+  Matrix Big;  // big x big, for the memory-bound kernels
+  Matrix Y;    // big x big, updated by axpy
+  Matrix v;    // big x 1
+  Matrix w;    // big x 1
+} perf_data;
+
+typedef struct {
+  const char *name;
+  const char *unit;  // throughput unit reported and stored
+  la_status (*run)(perf_data *d);
+  double work;       // units of work per run (flops or bytes)
+} perf_case;
+
+static la_status run_mul(perf_data *d) {
+    Matrix C = (Matrix){0};
+    la_status st = la_mul(&C, &d->A, &d->B);
+    la_matrix_free(&C);
+    return st;
+}
+
+static la_status run_par_mul(perf_data *d) {
+    Matrix C = (Matrix){0};
+    la_status st = la_par_mul(&C, &d->A, &d->B, NULL);
+    la_matrix_free(&C);
+    return st;
+}
+
+static la_status run_lu(perf_data *d) {
+    la_lu f = {0};
+    la_status st = la_lu_factor(&f, &d->A, NULL);
+    la_lu_free(&f);
+    return st;
+}
+
+static la_status run_par_lu(perf_data *d) {
+    la_lu f = {0};
+    la_status st = la_par_lu_factor(&f, &d->A, NULL);
+    la_lu_free(&f);
+    return st;
+}
+
+static la_status run_trsm(perf_data *d) {
+    Matrix X = (Matrix){0};
+    la_status st = la_matrix_copy(&X, &d->B);
+    if (st == LA_OK) st = la_trsm(LA_LEFT, LA_LOWER, LA_NO_TRANS, LA_NON_UNIT, 1.0, &d->A, &X);
+    la_matrix_free(&X);
+    return st;
+}
+
+static la_status run_gemv(perf_data *d) {
+    return la_gemv(LA_NO_TRANS, 1.0, &d->Big, &d->v, 0.0, &d->w);
+}
+
+static la_status run_reduce(perf_data *d) {
+    la_stats st = {0};
+    return la_reduce(&st, &d->Big, LA_STAT_SUM | LA_STAT_FRO | LA_STAT_NORMINF | LA_STAT_MAXABS);
+}
+
+static la_status run_axpy(perf_data *d) {
+    return la_axpy(&d->Y, 1e-9, &d->Big);
+}
+
+// ---------------- Baseline file ----------------
+
+typedef struct {
+  char name[64];
+  double value;
+} baseline_entry;
+
+// Lines are "name value", '#' starts a comment. A missing file is empty.
+static size_t read_baseline(const char *path, baseline_entry *out, size_t max) {
+    FILE *fp = fopen(path, "r");
+    if (!fp) return 0;
+
+    size_t count = 0;
+    char line[256];
+    while (count < max && fgets(line, sizeof(line), fp)) {
+        if (line[0] == '#') continue;
+        if (sscanf(line, "%63s %lf", out[count].name, &out[count].value) == 2) count++;
+    }
+    fclose(fp);
+    return count;
+}
+
+static const baseline_entry *find_baseline(const baseline_entry *b, size_t count,
+                                           const char *name) {
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(b[i].name, name) == 0) return &b[i];
+    }
+    return NULL;
+}
+
+// ---------------- Accuracy ----------------
+
+// ||A x - b||_inf / (||A||_inf ||x||_inf + ||b||_inf) for n x k x and b
+static double scaled_residual(const Matrix *A, const Matrix *X, const Matrix *B) {
+    Matrix AX = (Matrix){0}, R = (Matrix){0};
+    double rn = INFINITY, an = 0.0, xn = 0.0, bn = 0.0;
+    if (la_mul(&AX, A, X) == LA_OK && la_sub(&R, &AX, B) == LA_OK &&
+        la_norm_inf(&an, A) == LA_OK && la_max_abs(&xn, X) == LA_OK &&
+        la_max_abs(&bn, B) == LA_OK) {
+        la_max_abs(&rn, &R);
+    }
+    la_matrix_free(&AX);
+    la_matrix_free(&R);
+    return rn / (an * xn + bn);
+}
+
+// Random dense systems through each solver; backward stable LU keeps the
+// scaled residual within a modest multiple of n * eps.
+static int check_accuracy(void) {
+    static const size_t sizes[] = {300, 700};
+    int failed = 0;
+    unsigned seed = 2024u;
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        const size_t n = sizes[s];
+        const double limit = 100.0 * (double)n * DBL_EPSILON;
+        Matrix A = (Matrix){0}, b = (Matrix){0}, B = (Matrix){0};
+        if (la_matrix_init(&A, n, n) != LA_OK || la_matrix_init(&b, n, 1) != LA_OK ||
+            la_matrix_init(&B, n, 8) != LA_OK) {
+            la_matrix_free(&B);
+            la_matrix_free(&b);
+            la_matrix_free(&A);
+            return 1;
+        }
+        fill_random(&A, &seed);
+        fill_random(&b, &seed);
+        fill_random(&B, &seed);
+
+        Matrix x1 = (Matrix){0}, x2 = (Matrix){0}, X = (Matrix){0};
+        la_lu f = {0};
+        const double r1 = la_solve(&x1, &A, &b) == LA_OK
+                              ? scaled_residual(&A, &x1, &b) : INFINITY;
+        const double r2 = la_par_solve(&x2, &A, &b, NULL) == LA_OK
+                              ? scaled_residual(&A, &x2, &b) : INFINITY;
+        double r3 = INFINITY;
+        if (la_lu_factor(&f, &A, NULL) == LA_OK && la_lu_solve(&X, &f, &B) == LA_OK) {
+            r3 = scaled_residual(&A, &X, &B);
+        }
+
+        const char *names[3] = {"la_solve", "la_par_solve", "la_lu_solve (8 rhs)"};
+        const double res[3] = {r1, r2, r3};
+        for (int k = 0; k < 3; k++) {
+            const int ok = res[k] <= limit;
+            printf("residual %-20s n=%-5zu %.2e (limit %.2e) %s\n", names[k], n, res[k], limit,
+                   ok ? "ok" : "FAIL");
+            if (!ok) failed = 1;
+        }
+
+        la_lu_free(&f);
+        la_matrix_free(&X);
+        la_matrix_free(&x2);
+        la_matrix_free(&x1);
+        la_matrix_free(&B);
+        la_matrix_free(&b);
+        la_matrix_free(&A);
+    }
+    return failed;
+}
+
+// ---------------- Driver ----------------
+
+// Whole string must be a number in [0, 1)
+static int parse_tolerance(const char *s, double *out) {
+    char *end = NULL;
+    const double v = strtod(s, &end);
+    if (end == s || *end != '\0' || !(v >= 0.0 && v < 1.0)) return 0;
+    *out = v;
+    return 1;
+}
+
+static int usage(const char *prog) {
+    fprintf(stderr,
+            "usage: %s <baseline> [--tolerance f (0 <= f < 1)] [--update]\n"
+            "       %s --accuracy-only\n",
+            prog, prog);
+    return 2;
+}
+
+int main(int argc, char **argv) {
+    const char *path = NULL;
+    double tol = LA_PERF_DEFAULT_TOLERANCE;
+    int update = 0;
+
+    if (argc == 2 && strcmp(argv[1], "--accuracy-only") == 0) {
+        const int failed = check_accuracy();
+        printf("perf_la: accuracy %s\n", failed ? "FAIL" : "PASS");
+        return failed ? 1 : 0;
+    }
+
+    const char *env = getenv("LA_PERF_TOLERANCE");
+    if (env && *env && !parse_tolerance(env, &tol)) {
+        fprintf(stderr, "perf_la: bad LA_PERF_TOLERANCE '%s'\n", env);
+        return usage(argv[0]);
+    }
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--tolerance") == 0) {
+            if (i + 1 >= argc || !parse_tolerance(argv[++i], &tol)) return usage(argv[0]);
+        } else if (strcmp(argv[i], "--update") == 0) {
+            update = 1;
+        } else if (argv[i][0] == '-' || path) {
+            return usage(argv[0]);
+        } else {
+            path = argv[i];
+        }
+    }
+    if (!path || !(tol >= 0.0 && tol < 1.0)) return usage(argv[0]);
+
+    const size_t n = 400;
+    const size_t big = 2048;
+    perf_data d = {0};
+    if (la_matrix_init(&d.A, n, n) != LA_OK || la_matrix_init(&d.B, n, n) != LA_OK ||
+        la_matrix_init(&d.Big, big, big) != LA_OK || la_matrix_init(&d.Y, big, big) != LA_OK ||
+        la_matrix_init(&d.v, big, 1) != LA_OK ||
+        la_matrix_init(&d.w, big, 1) != LA_OK) {
+        fprintf(stderr, "perf_la: allocation failed\n");
+        return 1;
+    }
+    unsigned seed = 7u;
+    fill_random(&d.A, &seed);
+    fill_random(&d.B, &seed);
+    fill_random(&d.Big, &seed);
+    fill_random(&d.Y, &seed);
+    fill_random(&d.v, &seed);
+    for (size_t i = 0; i < n; i++) {
+        LA_AT(&d.A, i, i) += (double)n;
+    }
+
+    const double nd = (double)n;
+    const double bytes = (double)big * (double)big * sizeof(double);
+    const perf_case cases[] = {
+        {"mul", "GFLOP/s", run_mul, 2.0 * nd * nd * nd},
+        {"par_mul", "GFLOP/s", run_par_mul, 2.0 * nd * nd * nd},
+        {"lu_factor", "GFLOP/s", run_lu, 2.0 * nd * nd * nd / 3.0},
+        {"par_lu_factor", "GFLOP/s", run_par_lu, 2.0 * nd * nd * nd / 3.0},
+        {"trsm", "GFLOP/s", run_trsm, nd * nd * nd},
+        {"gemv", "GB/s", run_gemv, bytes},
+        {"reduce", "GB/s", run_reduce, bytes},
+        {"axpy", "GB/s", run_axpy, 3.0 * bytes},
+    };
+    const size_t ncases = sizeof(cases) / sizeof(cases[0]);
+
+    baseline_entry base[PERF_MAX_CASES];
+    const size_t nbase = read_baseline(path, base, PERF_MAX_CASES);
+    if (nbase == 0 && !update) {
+        fprintf(stderr, "perf_la: no baseline in %s (create one with --update)\n", path);
+    }
+
+    int failed = 0;
+    double measured[PERF_MAX_CASES];
+    printf("%-14s %10s %10s %8s\n", "kernel", "measured", "baseline", "ratio");
+    for (size_t c = 0; c < ncases; c++) {
+        double best = 0.0;
+        int ok = 1;
+        for (int r = 0; r < PERF_REPS && ok; r++) {
+            const double t0 = now_seconds();
+            double t = 0.0;
+            size_t runs = 0;
+            do {
+                ok = cases[c].run(&d) == LA_OK;
+                runs++;
+                t = now_seconds() - t0;
+            } while (ok && t < PERF_MIN_SECONDS);
+            if (r == 0 || t / (double)runs < best) best = t / (double)runs;
+        }
+        if (!ok) {
+            printf("%-14s failed to run\n", cases[c].name);
+            failed = 1;
+            measured[c] = 0.0;
+            continue;
+        }
+        measured[c] = cases[c].work / best * 1e-9;
+
+        const baseline_entry *b = find_baseline(base, nbase, cases[c].name);
+        if (!b || update) {
+            // Without --update a kernel with no baseline would never be checked
+            printf("%-14s %10.3f %10s %8s %s%s\n", cases[c].name, measured[c], "-", "-",
+                   cases[c].unit, update ? "" : "  MISSING BASELINE");
+            if (!update) failed = 1;
+            continue;
+        }
+        const double ratio = measured[c] / b->value;
+        const int slow = ratio < 1.0 - tol;
+        printf("%-14s %10.3f %10.3f %8.2f %s%s\n", cases[c].name, measured[c], b->value, ratio,
+               cases[c].unit, slow ? "  REGRESSION" : "");
+        if (slow) failed = 1;
+    }
+
+    if (update) {
+        FILE *fp = fopen(path, "w");
+        if (!fp) {
+            fprintf(stderr, "perf_la: cannot write %s\n", path);
+            return 1;
+        }
+        fprintf(fp, "# perf_la baseline: kernel throughput (GFLOP/s or GB/s, higher is better)\n");
+        for (size_t c = 0; c < ncases; c++) {
+            fprintf(fp, "%s %.3f\n", cases[c].name, measured[c]);
+        }
+        fclose(fp);
+        printf("baseline written to %s\n", path);
+    }
+
+    if (check_accuracy() != 0) failed = 1;
+
+    la_matrix_free(&d.A);
+    la_matrix_free(&d.B);
+    la_matrix_free(&d.Big);
+    la_matrix_free(&d.Y);
+    la_matrix_free(&d.v);
+    la_matrix_free(&d.w);
+
+    printf("perf_la: %s (tolerance %.2f)\n", failed ? "FAIL" : "PASS", tol);
+    return failed ? 1 : 0;
+}
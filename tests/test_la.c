@@ -1,14 +1,44 @@
 #include <stdio.h>
 #include <math.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <dirent.h>
+#endif
 
 #include "la_matrix.h"
 #include "la_ops.h"
 #include "la_solve.h"
+#include "la_prof.h"
+#include "la_ooc.h"
+#include "la_par.h"
+#include "la_update.h"
+#include "la_cache.h"
+#include "la_band.h"
+#include "la_blas.h"
+#include "la_elem.h"
+#include "la_reduce.h"
+#include "la_proto.h"
 
 static int nearly_equal(double a, double b) {
     return fabs(a - b) < 1e-9;
 }
 
+// Open file descriptors of this process, or -1 when they cannot be listed
+static int open_fds(void) {
+#ifdef __linux__
+    DIR *d = opendir("/proc/self/fd");
+    if (!d) return -1;
+    int count = 0;
+    while (readdir(d)) count++;
+    closedir(d);
+    return count;
+#else
+    return -1;
+#endif
+}
+
 int main(void) {
     Matrix A  = (Matrix){0};
     Matrix B  = (Matrix){0};
@@ -95,7 +125,903 @@ int main(void) {
     if (!nearly_equal(LA_AT(&Ainv,1,1), -0.5))  return 34;
     la_matrix_free(&Ainv);
 
-    
+    // ---- Low-rank updates ----
+    // A + e0 e1^T = [1 3; 3 4], inverse = [-0.8 0.6; 0.6 -0.2]
+    {
+        Matrix U = (Matrix){0};
+        Matrix V = (Matrix){0};
+        Matrix xu = (Matrix){0};
+        la_lu fa = {0};
+
+        if (la_matrix_init(&U, 2, 1) != LA_OK) return 80;
+        if (la_matrix_init(&V, 2, 1) != LA_OK) return 80;
+        LA_AT(&U,0,0)=1; LA_AT(&U,1,0)=0;
+        LA_AT(&V,0,0)=0; LA_AT(&V,1,0)=1;
+
+        if (la_inverse(&Ainv, &A) != LA_OK) return 81;
+        if (la_inverse_update(&Ainv, &U, &V) != LA_OK) return 82;
+        if (!nearly_equal(LA_AT(&Ainv,0,0), -0.8)) return 83;
+        if (!nearly_equal(LA_AT(&Ainv,0,1),  0.6)) return 83;
+        if (!nearly_equal(LA_AT(&Ainv,1,0),  0.6)) return 83;
+        if (!nearly_equal(LA_AT(&Ainv,1,1), -0.2)) return 83;
+        la_matrix_free(&Ainv);
+
+        // Same update applied to a solve through the LU factors of A
+        if (la_lu_factor(&fa, &A, NULL) != LA_OK) return 84;
+        if (la_lu_solve_update(&xu, &fa, &U, &V, &b2) != LA_OK) return 84;
+        if (!nearly_equal(LA_AT(&xu,0,0), -0.8 * 5 + 0.6 * 5)) return 84;
+        if (!nearly_equal(LA_AT(&xu,1,0),  0.6 * 5 - 0.2 * 5)) return 84;
+
+        la_lu_free(&fa);
+        la_matrix_free(&xu);
+        la_matrix_free(&U);
+        la_matrix_free(&V);
+    }
+
+    // ---- Factorization cache ----
+    {
+        la_factor_cache *fc = NULL;
+        la_cache_stats cs;
+        Matrix xc = (Matrix){0};
+        double d = 0.0;
+
+        if (la_cache_create(&fc, 1 << 20) != LA_OK) return 90;
+        la_set_factor_cache(fc);
+
+        // Second solve with A2 and the det of A2 are hits
+        if (la_solve(&xc, &A2, &b2) != LA_OK) return 91;
+        la_matrix_free(&xc);
+        if (la_solve(&xc, &A2, &b2) != LA_OK) return 91;
+        if (LA_AT(&xc,0,0) != LA_AT(&x,0,0) || LA_AT(&xc,1,0) != LA_AT(&x,1,0)) return 92;
+        la_matrix_free(&xc);
+        if (la_det(&d, &A2) != LA_OK || !nearly_equal(d, 4.0)) return 93;
+
+        if (la_inverse(&Ainv, &A) != LA_OK) return 94;
+        if (!nearly_equal(LA_AT(&Ainv,1,0), 1.5)) return 94;
+        la_matrix_free(&Ainv);
+
+        if (la_cache_get_stats(fc, &cs) != LA_OK) return 95;
+        if (cs.hits != 2 || cs.misses != 2 || cs.entries != 2) return 95;
+
+        // A singular matrix is cached as a negative entry
+        Matrix Sg = (Matrix){0};
+        if (la_matrix_init(&Sg, 2, 2) != LA_OK) return 97;
+        la_matrix_fill(&Sg, 1.0);
+        for (int r = 0; r < 2; r++) {
+            if (la_det(&d, &Sg) != LA_ERR_SINGULAR || d != 0.0) return 97;
+            if (la_solve(&xc, &Sg, &b2) != LA_ERR_SINGULAR || xc.data) return 97;
+        }
+        if (la_cache_get_stats(fc, &cs) != LA_OK) return 98;
+        if (cs.misses != 3 || cs.hits != 5 || cs.entries != 3) return 98;
+        la_matrix_free(&Sg);
+
+        // A cap below one entry evicts everything and caches nothing new
+        la_set_factor_cache(NULL);
+        la_cache_destroy(fc);
+        if (la_cache_create(&fc, 64) != LA_OK) return 96;
+        if (la_cache_solve(fc, &xc, &A2, &b2) != LA_OK) return 96;
+        la_matrix_free(&xc);
+        if (la_cache_get_stats(fc, &cs) != LA_OK) return 96;
+        if (cs.entries != 0 || cs.bytes != 0 || cs.misses != 1) return 96;
+        la_cache_destroy(fc);
+    }
+
+    // ---- Banded and tridiagonal solvers ----
+    {
+        const size_t n = 7;
+        Matrix Ad = (Matrix){0};
+        Matrix bb = (Matrix){0};
+        Matrix xd = (Matrix){0};
+        Matrix xb = (Matrix){0};
+        la_band Ab = {0};
+        size_t kl = 0, ku = 0;
+
+        // kl = 2, ku = 1 with small diagonal so the band LU has to pivot
+        if (la_matrix_init(&Ad, n, n) != LA_OK) return 100;
+        if (la_matrix_init(&bb, n, 1) != LA_OK) return 100;
+        la_matrix_fill(&Ad, 0.0);
+        for (size_t i = 0; i < n; i++) {
+            LA_AT(&Ad,i,i) = 0.1 * (double)(i + 1);
+            if (i + 1 < n) LA_AT(&Ad,i,i+1) = 1.0 + (double)i;
+            if (i >= 1) LA_AT(&Ad,i,i-1) = 3.0 - (double)i;
+            if (i >= 2) LA_AT(&Ad,i,i-2) = 2.0;
+            LA_AT(&bb,i,0) = (double)i - 2.0;
+        }
+
+        if (la_band_bandwidth(&kl, &ku, &Ad) != LA_OK || kl != 2 || ku != 1) return 101;
+        if (la_band_from_matrix(&Ab, &Ad, 1, 1) != LA_ERR_DIM) return 101;
+        if (la_band_from_matrix(&Ab, &Ad, kl, ku) != LA_OK) return 101;
+
+        if (la_solve(&xd, &Ad, &bb) != LA_OK) return 102;
+        if (la_band_solve(&xb, &Ab, &bb) != LA_OK) return 102;
+        for (size_t i = 0; i < n; i++) {
+            if (fabs(LA_AT(&xb,i,0) - LA_AT(&xd,i,0)) > 1e-10) return 103;
+        }
+        la_matrix_free(&xb);
+
+        if (la_band_to_matrix(&xb, &Ab) != LA_OK) return 104;
+        for (size_t i = 0; i < n * n; i++) {
+            if (xb.data[i] != Ad.data[i]) return 104;
+        }
+        la_matrix_free(&xb);
+        la_matrix_free(&xd);
+        la_band_free(&Ab);
+
+        // Batched 1-D Laplacians (-1, 2 + r, -1) against the single solver
+        const size_t m = 5;
+        Matrix DL = (Matrix){0}, D = (Matrix){0}, DU = (Matrix){0}, BB = (Matrix){0};
+        Matrix XB = (Matrix){0};
+        Matrix dl = (Matrix){0}, d = (Matrix){0}, du = (Matrix){0}, rhs = (Matrix){0};
+        if (la_matrix_init(&DL, m, n) != LA_OK || la_matrix_init(&D, m, n) != LA_OK ||
+            la_matrix_init(&DU, m, n) != LA_OK || la_matrix_init(&BB, m, n) != LA_OK) return 105;
+        for (size_t r = 0; r < m; r++) {
+            for (size_t i = 0; i < n; i++) {
+                LA_AT(&DL,r,i) = -1.0;
+                LA_AT(&D,r,i) = 2.0 + (double)r;
+                LA_AT(&DU,r,i) = -1.0;
+                LA_AT(&BB,r,i) = (double)(i * r) - 1.0;
+            }
+        }
+        if (la_tridiag_solve_batch(&XB, &DL, &D, &DU, &BB, 3) != LA_OK) return 106;
+        {
+            // Column-major diagonals go through the row-major fallback
+            Matrix Dc = (Matrix){0}, Xc = (Matrix){0};
+            if (la_matrix_convert(&Dc, &D, LA_COL_MAJOR, 0) != LA_OK) return 106;
+            if (la_tridiag_solve_batch(&Xc, &DL, &Dc, &DU, &BB, 2) != LA_OK) return 106;
+            if (memcmp(Xc.data, XB.data, m * n * sizeof(double)) != 0) return 106;
+            la_matrix_free(&Xc);
+            la_matrix_free(&Dc);
+        }
+
+        if (la_matrix_init(&dl, n, 1) != LA_OK || la_matrix_init(&d, n, 1) != LA_OK ||
+            la_matrix_init(&du, n, 1) != LA_OK || la_matrix_init(&rhs, n, 1) != LA_OK) return 105;
+        for (size_t r = 0; r < m; r++) {
+            for (size_t i = 0; i < n; i++) {
+                LA_AT(&dl,i,0) = LA_AT(&DL,r,i);
+                LA_AT(&d,i,0) = LA_AT(&D,r,i);
+                LA_AT(&du,i,0) = LA_AT(&DU,r,i);
+                LA_AT(&rhs,i,0) = LA_AT(&BB,r,i);
+            }
+            if (la_tridiag_solve(&xd, &dl, &d, &du, &rhs) != LA_OK) return 107;
+            for (size_t i = 0; i < n; i++) {
+                if (LA_AT(&xd,i,0) != LA_AT(&XB,r,i)) return 107;
+                // Residual of row i
+                double res = LA_AT(&d,i,0) * LA_AT(&xd,i,0) - LA_AT(&rhs,i,0);
+                if (i > 0) res += LA_AT(&dl,i,0) * LA_AT(&xd,i-1,0);
+                if (i + 1 < n) res += LA_AT(&du,i,0) * LA_AT(&xd,i+1,0);
+                if (fabs(res) > 1e-12) return 108;
+            }
+            la_matrix_free(&xd);
+        }
+
+        la_matrix_free(&dl); la_matrix_free(&d); la_matrix_free(&du); la_matrix_free(&rhs);
+        la_matrix_free(&DL); la_matrix_free(&D); la_matrix_free(&DU); la_matrix_free(&BB);
+        la_matrix_free(&XB);
+        la_matrix_free(&bb);
+        la_matrix_free(&Ad);
+    }
+
+    // ---- Triangular kernels ----
+    // For every side / uplo / trans / diag: trmm against a dense product
+    // with op(T), then trsm undoes it.
+    {
+        const size_t n = 70;  // more than one diagonal block
+        const size_t k = 3;
+        Matrix T = (Matrix){0}, Tf = (Matrix){0}, Tt = (Matrix){0};
+        Matrix B0 = (Matrix){0}, B0t = (Matrix){0}, Bw = (Matrix){0}, Ref = (Matrix){0};
+
+        if (la_matrix_init(&T, n, n) != LA_OK) return 110;
+        if (la_matrix_init(&B0, n, k) != LA_OK) return 110;
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = 0; j < n; j++) {
+                LA_AT(&T,i,j) = (i == j) ? 2.0 + 0.01 * (double)i
+                                         : 0.5 / (1.0 + (double)(i + 2 * j));
+            }
+            for (size_t c = 0; c < k; c++) LA_AT(&B0,i,c) = (double)(i % 7) - 0.5 * (double)c;
+        }
+        if (la_transpose(&B0t, &B0) != LA_OK) return 110;
+
+        for (int cfg = 0; cfg < 16; cfg++) {
+            const la_side side = (cfg & 1) ? LA_RIGHT : LA_LEFT;
+            const la_uplo uplo = (cfg & 2) ? LA_UPPER : LA_LOWER;
+            const la_trans trans = (cfg & 4) ? LA_TRANS : LA_NO_TRANS;
+            const la_diag diag = (cfg & 8) ? LA_UNIT : LA_NON_UNIT;
+            const Matrix *B = (side == LA_LEFT) ? &B0 : &B0t;
+
+            // Dense op(T) with the unused triangle zeroed
+            if (la_matrix_copy(&Tf, &T) != LA_OK) return 111;
+            for (size_t i = 0; i < n; i++) {
+                for (size_t j = 0; j < n; j++) {
+                    if ((uplo == LA_LOWER && j > i) || (uplo == LA_UPPER && i > j)) LA_AT(&Tf,i,j) = 0.0;
+                    if (i == j && diag == LA_UNIT) LA_AT(&Tf,i,j) = 1.0;
+                }
+            }
+            if (trans == LA_TRANS) {
+                if (la_transpose(&Tt, &Tf) != LA_OK) return 111;
+                la_matrix_free(&Tf);
+                Tf = Tt;
+                Tt = (Matrix){0};
+            }
+            if (side == LA_LEFT) {
+                if (la_mul(&Ref, &Tf, B) != LA_OK) return 111;
+            } else {
+                if (la_mul(&Ref, B, &Tf) != LA_OK) return 111;
+            }
+
+            if (la_matrix_copy(&Bw, B) != LA_OK) return 112;
+            if (la_trmm(side, uplo, trans, diag, 2.0, &T, &Bw) != LA_OK) return 112;
+            for (size_t i = 0; i < Bw.rows * Bw.cols; i++) {
+                if (fabs(Bw.data[i] - 2.0 * Ref.data[i]) > 1e-10) return 113;
+            }
+            if (la_trsm(side, uplo, trans, diag, 0.5, &T, &Bw) != LA_OK) return 114;
+            for (size_t i = 0; i < Bw.rows * Bw.cols; i++) {
+                if (fabs(Bw.data[i] - B->data[i]) > 1e-10) return 115;
+            }
+
+            la_matrix_free(&Bw);
+            la_matrix_free(&Ref);
+            la_matrix_free(&Tf);
+        }
+
+        // trsv agrees with a one-column trsm
+        Matrix xv = (Matrix){0};
+        if (la_matrix_init(&xv, n, 1) != LA_OK) return 116;
+        for (size_t i = 0; i < n; i++) LA_AT(&xv,i,0) = LA_AT(&B0,i,0);
+        if (la_trsv(LA_UPPER, LA_TRANS, LA_NON_UNIT, &T, &xv) != LA_OK) return 116;
+        if (la_matrix_copy(&Bw, &B0) != LA_OK) return 116;
+        if (la_trsm(LA_LEFT, LA_UPPER, LA_TRANS, LA_NON_UNIT, 1.0, &T, &Bw) != LA_OK) return 116;
+        for (size_t i = 0; i < n; i++) {
+            if (fabs(LA_AT(&xv,i,0) - LA_AT(&Bw,i,0)) > 1e-12) return 117;
+        }
+        if (la_trsv(LA_LOWER, LA_NO_TRANS, LA_UNIT, &T, &B0) != LA_ERR_DIM) return 118;
+
+        la_matrix_free(&xv);
+        la_matrix_free(&Bw);
+        la_matrix_free(&B0t);
+        la_matrix_free(&B0);
+        la_matrix_free(&T);
+    }
+
+    // ---- Elementwise, broadcast and vector ops ----
+    // A = [1 2; 3 4], B = [10 20; 30 40]
+    {
+        Matrix E = (Matrix){0};
+        Matrix r = (Matrix){0};
+        Matrix cv = (Matrix){0};
+        double v = 0.0;
+
+        if (la_scale(&E, -2.0, &A) != LA_OK || LA_AT(&E,1,0) != -6.0) return 130;
+        if (la_axpy(&E, 2.0, &A) != LA_OK || E.data[0] != 0.0 || E.data[3] != 0.0) return 130;
+        la_matrix_free(&E);
+
+        if (la_hadamard(&E, &A, &B) != LA_OK || LA_AT(&E,1,1) != 160.0) return 131;
+        la_matrix_free(&E);
+        if (la_divide(&E, &B, &A) != LA_OK || LA_AT(&E,0,1) != 10.0) return 131;
+        la_matrix_free(&E);
+
+        if (la_matrix_init(&r, 1, 2) != LA_OK || la_matrix_init(&cv, 2, 1) != LA_OK) return 132;
+        r.data[0] = 10; r.data[1] = 20;
+        cv.data[0] = 1; cv.data[1] = 2;
+        if (la_bcast_row(&E, &A, &r, LA_ELEM_ADD) != LA_OK) return 132;
+        if (LA_AT(&E,1,0) != 13.0 || LA_AT(&E,1,1) != 24.0) return 132;
+        la_matrix_free(&E);
+        if (la_bcast_col(&E, &A, &cv, LA_ELEM_DIV) != LA_OK) return 133;
+        if (LA_AT(&E,0,1) != 2.0 || LA_AT(&E,1,0) != 1.5) return 133;
+        la_matrix_free(&E);
+        if (la_bcast_row(&E, &A, &cv, LA_ELEM_ADD) != LA_ERR_DIM) return 133;
+        if (la_bcast_row(&E, &A, &r, (la_elem_op)7) != LA_ERR_DIM || E.data) return 133;
+        if (la_bcast_col(&E, &A, &cv, (la_elem_op)7) != LA_ERR_DIM || E.data) return 133;
+
+        // kron(A, B)(2 + 1, 2 + 0) = A(1,1) * B(1,0) = 4 * 30
+        if (la_kron(&E, &A, &B) != LA_OK || E.rows != 4 || E.cols != 4) return 134;
+        if (LA_AT(&E,3,2) != 120.0 || LA_AT(&E,0,3) != 40.0 || LA_AT(&E,2,1) != 60.0) return 134;
+        la_matrix_free(&E);
+
+        if (la_dot(&v, &r, &cv) != LA_OK || v != 50.0) return 135;
+        if (la_nrm2(&v, &r) != LA_OK || !nearly_equal(v, sqrt(500.0))) return 135;
+        r.data[0] = 3e200; r.data[1] = 4e200;
+        if (la_nrm2(&v, &r) != LA_OK || fabs(v / 5e200 - 1.0) > 1e-15) return 135;
+
+        // y = A x and y = A^T x with x = (1, 2)
+        if (la_matrix_init(&E, 2, 1) != LA_OK) return 136;
+        if (la_gemv(LA_NO_TRANS, 1.0, &A, &cv, 0.0, &E) != LA_OK) return 136;
+        if (E.data[0] != 5.0 || E.data[1] != 11.0) return 136;
+        if (la_gemv(LA_TRANS, 1.0, &A, &cv, -1.0, &E) != LA_OK) return 136;
+        if (E.data[0] != 2.0 || E.data[1] != -1.0) return 136;
+        la_matrix_free(&E);
+
+        la_matrix_free(&r);
+        la_matrix_free(&cv);
+    }
+
+    // ---- Reductions ----
+    {
+        // A = [1 2; 3 4]
+        double v = 0.0;
+        if (la_norm_fro(&v, &A) != LA_OK || !nearly_equal(v, sqrt(30.0))) return 140;
+        if (la_norm_1(&v, &A) != LA_OK || v != 6.0) return 140;
+        if (la_norm_inf(&v, &A) != LA_OK || v != 7.0) return 140;
+        if (la_trace(&v, &A) != LA_OK || v != 5.0) return 140;
+        if (la_max_abs(&v, &B) != LA_OK || v != 40.0) return 140;
+
+        // Trace alone walks the diagonal; with others it joins the sweep
+        Matrix At = (Matrix){0};
+        la_stats ts = {0};
+        if (la_matrix_convert(&At, &A, LA_TILED, 0) != LA_OK) return 140;
+        if (la_trace(&v, &At) != LA_OK || v != 5.0) return 140;
+        la_matrix_free(&At);
+        if (la_matrix_convert(&At, &A, LA_COL_MAJOR, 0) != LA_OK) return 140;
+        if (la_trace(&v, &At) != LA_OK || v != 5.0) return 140;
+        if (la_reduce(&ts, &At, LA_STAT_TRACE | LA_STAT_SUM) != LA_OK) return 140;
+        if (ts.trace != 5.0 || ts.sum != 10.0) return 140;
+        la_matrix_free(&At);
+
+        Matrix S = (Matrix){0};
+        if (la_row_sums(&S, &A) != LA_OK || S.rows != 2 || S.cols != 1) return 141;
+        if (S.data[0] != 3.0 || S.data[1] != 7.0) return 141;
+        la_matrix_free(&S);
+        if (la_col_sums(&S, &A) != LA_OK || S.rows != 1 || S.cols != 2) return 141;
+        if (S.data[0] != 4.0 || S.data[1] != 6.0) return 141;
+        la_matrix_free(&S);
+
+        Matrix R = (Matrix){0};
+        if (la_matrix_init(&R, 2, 3) != LA_OK) return 142;
+        if (la_trace(&v, &R) != LA_ERR_DIM) return 142;
+        la_matrix_free(&R);
+
+        // Every statistic from one sweep, serial and threaded
+        const size_t m = 1500, n = 700;
+        if (la_matrix_init(&R, m, n) != LA_OK) return 143;
+        unsigned seed = 7u;
+        for (size_t k = 0; k < m * n; k++) {
+            seed = seed * 1103515245u + 12345u;
+            R.data[k] = ((double)(seed >> 8) / 16777216.0 - 0.5) * 4.0;
+        }
+        double rs[1500], cs[700], rs2[1500], cs2[700];
+        const unsigned all = LA_STAT_SUM | LA_STAT_FRO | LA_STAT_NORM1 | LA_STAT_NORMINF |
+                             LA_STAT_MAXABS | LA_STAT_MIN | LA_STAT_MAX |
+                             LA_STAT_ROW_SUMS | LA_STAT_COL_SUMS;
+        la_stats st = {0}, st2 = {0};
+        st.row_sums = rs;
+        st.col_sums = cs;
+        st2.row_sums = rs2;
+        st2.col_sums = cs2;
+        la_blas_set_threads(1);
+        if (la_reduce(&st, &R, all) != LA_OK) return 143;
+        la_blas_set_threads(4);
+        if (la_reduce(&st2, &R, all) != LA_OK) return 143;
+        la_blas_set_threads(0);
+
+        // Reference sums in long double
+        long double sum = 0, ssq = 0, n1 = 0, ninf = 0;
+        double amax = 0, mn = R.data[0], mx = R.data[0];
+        for (size_t i = 0; i < m; i++) {
+            long double r = 0, ra = 0;
+            for (size_t j = 0; j < n; j++) {
+                const double x = LA_AT(&R,i,j);
+                r += x;
+                ra += fabs(x);
+                ssq += (long double)x * x;
+                if (fabs(x) > amax) amax = fabs(x);
+                if (x < mn) mn = x;
+                if (x > mx) mx = x;
+            }
+            sum += r;
+            if (ra > ninf) ninf = ra;
+            if (fabs(rs[i] - (double)r) > 1e-12) return 144;
+        }
+        for (size_t j = 0; j < n; j++) {
+            long double c = 0, ca = 0;
+            for (size_t i = 0; i < m; i++) {
+                c += LA_AT(&R,i,j);
+                ca += fabs(LA_AT(&R,i,j));
+            }
+            if (ca > n1) n1 = ca;
+            if (fabs(cs[j] - (double)c) > 1e-12) return 145;
+        }
+        if (fabs(st.sum - (double)sum) > 1e-10) return 146;
+        if (fabs(st.fro - (double)sqrtl(ssq)) > 1e-12 * st.fro) return 146;
+        if (fabs(st.norm1 - (double)n1) > 1e-12 * st.norm1) return 146;
+        if (fabs(st.norminf - (double)ninf) > 1e-12 * st.norminf) return 146;
+        if (st.maxabs != amax || st.min != mn || st.max != mx) return 146;
+        if (fabs(st2.sum - st.sum) > 1e-10 || fabs(st2.fro - st.fro) > 1e-12 * st.fro) return 147;
+        if (st2.norm1 != st.norm1 || st2.maxabs != st.maxabs) return 147;
+        la_matrix_free(&R);
+
+        // Compensated sum: 10^6 copies of 0.1, and a norm that would overflow
+        if (la_matrix_init(&R, 1000, 1000) != LA_OK) return 148;
+        la_matrix_fill(&R, 0.1);
+        st = (la_stats){0};
+        if (la_reduce(&st, &R, LA_STAT_SUM) != LA_OK) return 148;
+        if (fabs(st.sum - 1e5) > 1e-9) return 148;
+        la_matrix_fill(&R, 1e300);
+        if (la_norm_fro(&v, &R) != LA_OK || fabs(v / 1e303 - 1.0) > 1e-12) return 149;
+        la_matrix_free(&R);
+    }
+
+    // ---- Storage layouts ----
+    {
+        // A = [1 2; 3 4] as a caller-owned column-major array
+        double cm[4] = {1.0, 3.0, 2.0, 4.0};
+        Matrix Ac = (Matrix){0};
+        if (la_matrix_wrap(&Ac, 2, 2, cm, LA_COL_MAJOR, 0) != LA_OK) return 150;
+        if (LA_REF(&Ac, 1, 0) != 3.0 || LA_REF(&Ac, 0, 1) != 2.0) return 150;
+        Matrix Bad = (Matrix){0};
+        if (la_matrix_init_layout(&Bad, 2, 2, (la_layout)5, 0) != LA_ERR_DIM || Bad.data) {
+            return 150;
+        }
+
+        double d = 0.0;
+        if (la_det(&d, &Ac) != LA_OK || !nearly_equal(d, -2.0)) return 151;
+        Matrix E = (Matrix){0};
+        if (la_transpose(&E, &Ac) != LA_OK || LA_AT(&E, 0, 1) != 3.0) return 151;
+        la_matrix_free(&E);
+        double v = 0.0;
+        if (la_norm_1(&v, &Ac) != LA_OK || v != 6.0) return 151;
+        if (la_norm_inf(&v, &Ac) != LA_OK || v != 7.0) return 151;
+        if (la_row_sums(&E, &Ac) != LA_OK || E.data[0] != 3.0 || E.data[1] != 7.0) return 151;
+        la_matrix_free(&E);
+
+        // Mixed layouts give a row-major result; matching ones keep theirs
+        if (la_add(&E, &Ac, &A) != LA_OK || E.layout != LA_ROW_MAJOR) return 152;
+        if (LA_AT(&E, 1, 0) != 6.0) return 152;
+        la_matrix_free(&E);
+        if (la_mul(&E, &Ac, &Ac) != LA_OK || E.layout != LA_COL_MAJOR) return 152;
+        if (LA_REF(&E, 0, 0) != 7.0 || LA_REF(&E, 0, 1) != 10.0 || LA_REF(&E, 1, 0) != 15.0) {
+            return 152;
+        }
+        la_matrix_free(&E);
+
+        la_matrix_free(&Ac);
+        if (Ac.data != NULL || cm[1] != 3.0) return 153;
+
+        // 37 x 29 through every layout, tiles of 8 with ragged edges
+        const size_t m = 37, n = 29;
+        Matrix R = (Matrix){0}, C = (Matrix){0}, T = (Matrix){0}, R2 = (Matrix){0};
+        if (la_matrix_init(&R, m, n) != LA_OK) return 154;
+        for (size_t i = 0; i < m; i++) {
+            for (size_t j = 0; j < n; j++) LA_AT(&R, i, j) = (double)(i * n + j % 7) - 3.0 * j;
+        }
+        if (la_matrix_convert(&C, &R, LA_COL_MAJOR, 0) != LA_OK) return 154;
+        if (la_matrix_convert(&T, &C, LA_TILED, 8) != LA_OK) return 154;
+        if (la_matrix_convert(&R2, &T, LA_ROW_MAJOR, 0) != LA_OK) return 154;
+        if (la_matrix_storage(&T) != 40 * 32) return 154;
+        for (size_t k = 0; k < m * n; k++) {
+            if (R2.data[k] != R.data[k]) return 154;
+        }
+        for (size_t i = 0; i < m; i++) {
+            for (size_t j = 0; j < n; j++) {
+                if (LA_REF(&C, i, j) != LA_AT(&R, i, j) || LA_REF(&T, i, j) != LA_AT(&R, i, j)) {
+                    return 154;
+                }
+            }
+        }
+
+        // Products in each layout agree with the row-major one
+        Matrix Rt = (Matrix){0}, Ct = (Matrix){0}, Tt = (Matrix){0};
+        Matrix P = (Matrix){0}, Pc = (Matrix){0}, Pt = (Matrix){0}, Pp = (Matrix){0};
+        if (la_transpose(&Rt, &R) != LA_OK) return 155;
+        if (la_matrix_convert(&Ct, &Rt, LA_COL_MAJOR, 0) != LA_OK) return 155;
+        if (la_matrix_convert(&Tt, &Rt, LA_TILED, 8) != LA_OK) return 155;
+        if (la_mul(&P, &R, &Rt) != LA_OK) return 155;
+        if (la_mul(&Pc, &C, &Ct) != LA_OK || Pc.layout != LA_COL_MAJOR) return 155;
+        if (la_mul(&Pt, &T, &Tt) != LA_OK || Pt.layout != LA_TILED) return 155;
+        if (la_par_mul(&Pp, &T, &Ct, NULL) != LA_OK) return 155;
+        for (size_t i = 0; i < m; i++) {
+            for (size_t j = 0; j < m; j++) {
+                const double p = LA_AT(&P, i, j);
+                if (fabs(LA_REF(&Pc, i, j) - p) > 1e-9 * fabs(p) + 1e-9) return 155;
+                if (fabs(LA_REF(&Pt, i, j) - p) > 1e-9 * fabs(p) + 1e-9) return 155;
+                if (fabs(LA_AT(&Pp, i, j) - p) > 1e-9 * fabs(p) + 1e-9) return 155;
+            }
+        }
+
+        // Column-major and tiled solves match the row-major one
+        Matrix S = (Matrix){0}, Sc = (Matrix){0}, St = (Matrix){0}, rhs = (Matrix){0};
+        Matrix X = (Matrix){0}, Xc = (Matrix){0}, Xt = (Matrix){0};
+        if (la_matrix_init(&rhs, m, 1) != LA_OK) return 156;
+        for (size_t i = 0; i < m; i++) rhs.data[i] = (double)i - 5.0;
+        if (la_add(&S, &P, &P) != LA_OK) return 156;
+        for (size_t i = 0; i < m; i++) LA_AT(&S, i, i) += 1000.0;
+        if (la_matrix_convert(&Sc, &S, LA_COL_MAJOR, 0) != LA_OK) return 156;
+        if (la_matrix_convert(&St, &S, LA_TILED, 8) != LA_OK) return 156;
+        if (la_solve(&X, &S, &rhs) != LA_OK) return 156;
+        if (la_solve(&Xc, &Sc, &rhs) != LA_OK) return 156;
+        if (la_solve(&Xt, &St, &rhs) != LA_OK) return 156;
+        for (size_t i = 0; i < m; i++) {
+            if (fabs(Xc.data[i] - X.data[i]) > 1e-12 || fabs(Xt.data[i] - X.data[i]) > 1e-12) {
+                return 156;
+            }
+        }
+
+        // Triangular solve with column-major T and B, both sides
+        for (int side = 0; side < 2; side++) {
+            Matrix Bm = (Matrix){0}, Bc = (Matrix){0};
+            const size_t br = side ? 5 : m, bc = side ? m : 5;
+            if (la_matrix_init(&Bm, br, bc) != LA_OK) return 157;
+            for (size_t k = 0; k < br * bc; k++) Bm.data[k] = (double)(k % 11) - 4.0;
+            if (la_matrix_convert(&Bc, &Bm, LA_COL_MAJOR, 0) != LA_OK) return 157;
+            if (la_trsm((la_side)side, LA_LOWER, LA_TRANS, LA_NON_UNIT, 2.0, &S, &Bm) != LA_OK) {
+                return 157;
+            }
+            if (la_trsm((la_side)side, LA_LOWER, LA_TRANS, LA_NON_UNIT, 2.0, &Sc, &Bc) != LA_OK) {
+                return 157;
+            }
+            for (size_t i = 0; i < br; i++) {
+                for (size_t j = 0; j < bc; j++) {
+                    if (fabs(LA_REF(&Bc, i, j) - LA_AT(&Bm, i, j)) > 1e-12) return 157;
+                }
+            }
+            la_matrix_free(&Bm);
+            la_matrix_free(&Bc);
+        }
+
+        // gemv on column-major storage
+        Matrix y = (Matrix){0}, yc = (Matrix){0};
+        if (la_matrix_init(&y, n, 1) != LA_OK || la_matrix_init(&yc, n, 1) != LA_OK) return 158;
+        if (la_gemv(LA_TRANS, 1.0, &R, &rhs, 0.0, &y) != LA_OK) return 158;
+        if (la_gemv(LA_TRANS, 1.0, &C, &rhs, 0.0, &yc) != LA_OK) return 158;
+        for (size_t j = 0; j < n; j++) {
+            if (fabs(y.data[j] - yc.data[j]) > 1e-9) return 158;
+        }
+
+        Matrix *ms[] = {&R, &C, &T, &R2, &Rt, &Ct, &Tt, &P, &Pc, &Pt, &Pp, &S, &Sc, &St,
+                        &rhs, &X, &Xc, &Xt, &y, &yc};
+        for (size_t k = 0; k < sizeof(ms) / sizeof(ms[0]); k++) la_matrix_free(ms[k]);
+    }
+
+    // ---- Deterministic mode ----
+    {
+        const size_t m = 3000, n = 400;
+        const size_t counts[3] = {1, 3, 8};
+        Matrix R = (Matrix){0}, L = (Matrix){0};
+        if (la_matrix_init(&R, m, n) != LA_OK || la_matrix_init(&L, n, n) != LA_OK) return 160;
+        // Full mantissas, so the order of additions shows in the result
+        unsigned seed = 11u;
+        for (size_t k = 0; k < m * n; k++) {
+            seed = seed * 1103515245u + 12345u;
+            R.data[k] = ((double)(seed >> 8) / 16777216.0 - 0.5) * (1.0 + (double)(k % 97) / 97.0);
+        }
+        la_matrix_fill(&L, 0.0);
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = 0; j <= i; j++) LA_AT(&L, i, j) = (i == j) ? 4.0 : R.data[i * n + j];
+        }
+
+        // Column sums are split by row partitions, so without the mode
+        // their bits follow the thread count
+        const unsigned w = LA_STAT_SUM | LA_STAT_FRO | LA_STAT_NORM1 | LA_STAT_COL_SUMS;
+        double cs[3][400];
+        la_stats ref = {0};
+
+        la_set_deterministic(1);
+        if (!la_get_deterministic()) return 160;
+        Matrix Xref = (Matrix){0}, Yref = (Matrix){0};
+        for (int t = 0; t < 3; t++) {
+            la_blas_set_threads(counts[t]);
+            la_stats st = {0};
+            st.col_sums = cs[t];
+            if (la_reduce(&st, &R, w) != LA_OK) return 161;
+
+            // L^-T applied to 3000 right-hand sides, and y += 0.3 x
+            Matrix X = (Matrix){0}, Y = (Matrix){0};
+            if (la_transpose(&X, &R) != LA_OK || la_matrix_copy(&Y, &R) != LA_OK) return 162;
+            if (la_trsm(LA_LEFT, LA_LOWER, LA_TRANS, LA_NON_UNIT, 1.0, &L, &X) != LA_OK) return 162;
+            if (la_axpy(&Y, 0.3, &R) != LA_OK) return 162;
+
+            if (t == 0) {
+                ref = st;
+                Xref = X;
+                Yref = Y;
+                continue;
+            }
+            if (memcmp(&st.sum, &ref.sum, sizeof(double)) != 0) return 163;
+            if (memcmp(&st.fro, &ref.fro, sizeof(double)) != 0) return 163;
+            if (memcmp(&st.norm1, &ref.norm1, sizeof(double)) != 0) return 163;
+            if (memcmp(cs[t], cs[0], n * sizeof(double)) != 0) return 163;
+            if (memcmp(X.data, Xref.data, m * n * sizeof(double)) != 0) return 164;
+            if (memcmp(Y.data, Yref.data, m * n * sizeof(double)) != 0) return 164;
+            la_matrix_free(&X);
+            la_matrix_free(&Y);
+        }
+
+        // Same bits on every build and target: no fused multiply-add, so
+        // y + 0.3 x rounds the product first, and fixed stored results
+        double d = 0.0;
+        Matrix rv = (Matrix){0};
+        la_matrix_wrap(&rv, m * n, 1, R.data, LA_ROW_MAJOR, 0);
+        if (la_dot(&d, &rv, &rv) != LA_OK || d != 0x1.c48bb655ba687p+17) return 165;
+        if (ref.fro != 0x1.e15b16f4534d3p+8) return 165;
+        for (size_t k = 0; k < m * n; k++) {
+            volatile double p = 0.3 * R.data[k];
+            if (Yref.data[k] != R.data[k] + p) return 165;
+        }
+
+        la_set_deterministic(0);
+        la_blas_set_threads(0);
+        la_matrix_free(&Xref);
+        la_matrix_free(&Yref);
+        la_matrix_free(&R);
+        la_matrix_free(&L);
+    }
+
+    // ---- Log-determinant ----
+    {
+        int sg = 0;
+        double ld = 0.0;
+
+        // det A = -2
+        if (la_logdet(&sg, &ld, &A) != LA_OK) return 120;
+        if (sg != -1 || !nearly_equal(ld, log(2.0))) return 121;
+
+        // 600 x 600 with det = 10^600 (and a sign flip per negative pivot)
+        const size_t n = 600;
+        Matrix Big = (Matrix){0};
+        if (la_matrix_init(&Big, n, n) != LA_OK) return 122;
+        la_matrix_fill(&Big, 0.0);
+        for (size_t i = 0; i < n; i++) {
+            LA_AT(&Big,i,i) = (i % 2) ? -10.0 : 10.0;
+            for (size_t j = i + 1; j < n; j++) LA_AT(&Big,i,j) = 1.0 / (double)(j + 1);
+        }
+        double d = 0.0;
+        if (la_det(&d, &Big) != LA_OK || !isinf(d)) return 123;
+        if (la_logdet(&sg, &ld, &Big) != LA_OK) return 124;
+        if (sg != 1 || fabs(ld - (double)n * log(10.0)) > 1e-9) return 125;
+        la_matrix_free(&Big);
+
+        // Batch with one singular member
+        Matrix Bs[3] = {A, A2, (Matrix){0}};
+        int sgs[3];
+        double lds[3];
+        if (la_matrix_init(&Bs[2], 2, 2) != LA_OK) return 126;
+        la_matrix_fill(&Bs[2], 1.0);
+        if (la_logdet_batch(sgs, lds, Bs, 3, 2) != LA_ERR_SINGULAR) return 127;
+        if (sgs[0] != -1 || !nearly_equal(lds[0], log(2.0))) return 128;
+        if (sgs[1] != 1 || !nearly_equal(lds[1], log(4.0))) return 128;
+        if (sgs[2] != 0 || !isinf(lds[2])) return 128;
+        la_matrix_free(&Bs[2]);
+    }
+
+    // ---- Scale-aware solve and diagnostics ----
+    // 1e-14 * A2 is well conditioned but below the absolute pivot tolerance
+    Matrix As = (Matrix){0};
+    Matrix xs = (Matrix){0};
+    la_solve_info info;
+
+    if (la_matrix_init(&As, 2, 2) != LA_OK) return 40;
+    for (size_t i = 0; i < 4; i++) As.data[i] = 1e-14 * A2.data[i];
+
+    if (la_solve(&xs, &As, &b2) != LA_ERR_SINGULAR) return 41;
+    if (la_solve_ex(&xs, &As, &b2, NULL, &info) != LA_OK) return 42;
+    if (fabs(LA_AT(&xs,1,0) - 2.5e14) > 1e2) return 43;
+    if (info.berr > 1e-15) return 44;
+    la_matrix_free(&xs);
+
+    // la_det keeps la_solve's absolute rule; la_logdet scales with A
+    {
+        double ds = 1.0;
+        int sgs = 0;
+        double lds = 0.0;
+        if (la_det(&ds, &As) != LA_ERR_SINGULAR || ds != 0.0) return 47;
+        if (la_logdet(&sgs, &lds, &As) != LA_OK) return 48;
+        if (sgs != 1 || fabs(lds - log(4e-28)) > 1e-9) return 48;
+    }
+
+    // diag(1, 1e-3): rcond is exactly 1e-3
+    LA_AT(&As,0,0)=1; LA_AT(&As,0,1)=0;
+    LA_AT(&As,1,0)=0; LA_AT(&As,1,1)=1e-3;
+    if (la_solve_ex(&xs, &As, &b2, NULL, &info) != LA_OK) return 45;
+    if (!nearly_equal(info.rcond, 1e-3)) return 46;
+    la_matrix_free(&xs);
+    la_matrix_free(&As);
+
+    // ---- Instrumentation (only meaningful with -DLA_PROFILE=ON) ----
+    la_prof_stats ps;
+    la_prof_reset();
+    if (la_mul(&M, &A, &B) != LA_OK) return 50;
+    la_matrix_free(&M);
+    if (la_prof_get(LA_PROF_MUL, &ps) != LA_OK) return 51;
+    if (la_prof_enabled()) {
+        if (ps.calls != 1 || ps.flops != 16) return 52;
+        if (ps.bytes_alloc != 4 * sizeof(double)) return 53;
+    } else if (ps.calls != 0) {
+        return 54;
+    }
+
+    // Counters are inclusive: la_solve also records its la_lu_solve
+    la_prof_reset();
+    Matrix xp = (Matrix){0};
+    if (la_solve(&xp, &A2, &b2) != LA_OK) return 55;
+    la_matrix_free(&xp);
+    if (la_prof_get(LA_PROF_LU_SOLVE, &ps) != LA_OK) return 55;
+    if (ps.calls != (la_prof_enabled() ? 1u : 0u)) return 56;
+
+    // Short-lived worker threads must not leave counter fds behind
+    if (la_prof_enabled() && open_fds() >= 0) {
+        Matrix Bs[4] = {A, A2, A, A2};
+        int sgs[4];
+        double lds[4];
+        const int fds0 = open_fds();
+        for (int r = 0; r < 20; r++) {
+            if (la_logdet_batch(sgs, lds, Bs, 4, 4) != LA_OK) return 57;
+        }
+        if (open_fds() != fds0) return 58;
+    }
+
+    // ---- Out-of-core multiply and solve ----
+    // 37x37 system in 8x8 tiles (ragged edge) through a 4-tile cache
+    {
+        const size_t n = 37;
+        Matrix Ad = (Matrix){0};
+        Matrix bd = (Matrix){0};
+        Matrix Ref = (Matrix){0};
+        Matrix Got = (Matrix){0};
+        la_ooc_matrix *oa = NULL;
+        la_ooc_matrix *oc = NULL;
+
+        if (la_matrix_init(&Ad, n, n) != LA_OK) return 60;
+        if (la_matrix_init(&bd, n, 1) != LA_OK) return 60;
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = 0; j < n; j++) {
+                LA_AT(&Ad,i,j) = (double)((i * 7 + j * 13) % 11) - 5.0;
+            }
+            LA_AT(&Ad,i,i) += 0.5;
+            LA_AT(&bd,i,0) = (double)i;
+        }
+
+        if (la_ooc_create(&oa, "test_la_ooc_a.bin", n, n, 8, 4) != LA_OK) return 61;
+        if (la_ooc_create(&oc, "test_la_ooc_c.bin", n, n, 8, 4) != LA_OK) return 61;
+        if (la_ooc_write_block(oa, 0, 0, &Ad) != LA_OK) return 62;
+
+        if (la_ooc_mul(oc, oa, oa) != LA_OK) return 63;
+        if (la_ooc_read_block(&Got, oc, 0, 0, n, n) != LA_OK) return 64;
+        if (la_mul(&Ref, &Ad, &Ad) != LA_OK) return 64;
+        for (size_t i = 0; i < n * n; i++) {
+            if (!nearly_equal(Got.data[i], Ref.data[i])) return 65;
+        }
+        la_matrix_free(&Got);
+        la_matrix_free(&Ref);
+
+        if (la_ooc_solve(&Got, oa, &bd) != LA_OK) return 66;
+        if (la_solve(&Ref, &Ad, &bd) != LA_OK) return 67;
+        for (size_t i = 0; i < n; i++) {
+            if (fabs(LA_AT(&Got,i,0) - LA_AT(&Ref,i,0)) > 1e-8) return 68;
+        }
+
+        if (la_ooc_close(oa) != LA_OK) return 69;
+        if (la_ooc_close(oc) != LA_OK) return 69;
+        remove("test_la_ooc_a.bin");
+        remove("test_la_ooc_c.bin");
+        la_matrix_free(&Got);
+        la_matrix_free(&Ref);
+        la_matrix_free(&Ad);
+        la_matrix_free(&bd);
+    }
+
+    // ---- Tiled task-graph LU, Cholesky and GEMM ----
+    // 29x29 in 8x8 tiles on 3 threads must agree with the serial routines
+    {
+        const size_t n = 29;
+        const la_par_opts po = {3, 8, 1, 0.0};
+        Matrix Ad = (Matrix){0};
+        Matrix At = (Matrix){0};
+        Matrix Spd = (Matrix){0};
+        Matrix Lc = (Matrix){0};
+        Matrix Lt = (Matrix){0};
+        Matrix Ref = (Matrix){0};
+        Matrix Got = (Matrix){0};
+        la_lu fp = {0};
+        la_lu fs = {0};
+
+        if (la_matrix_init(&Ad, n, n) != LA_OK) return 70;
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = 0; j < n; j++) {
+                LA_AT(&Ad,i,j) = (double)((i * 5 + j * 3) % 7) - 3.0 + (i == j ? 0.25 : 0.0);
+            }
+        }
+
+        if (la_par_mul(&Got, &Ad, &Ad, &po) != LA_OK) return 71;
+        if (la_mul(&Ref, &Ad, &Ad) != LA_OK) return 71;
+        for (size_t i = 0; i < n * n; i++) {
+            if (Got.data[i] != Ref.data[i]) return 72;
+        }
+        la_matrix_free(&Got);
+        la_matrix_free(&Ref);
+
+        if (la_par_lu_factor(&fp, &Ad, &po) != LA_OK) return 73;
+        if (la_lu_factor(&fs, &Ad, NULL) != LA_OK) return 73;
+        if (fp.sign != fs.sign) return 74;
+        for (size_t i = 0; i < n; i++) {
+            if (fp.perm[i] != fs.perm[i]) return 74;
+        }
+        for (size_t i = 0; i < n * n; i++) {
+            if (!nearly_equal(fp.LU.data[i], fs.LU.data[i])) return 75;
+        }
+        la_lu_free(&fp);
+        la_lu_free(&fs);
+
+        // Spd = Ad Ad^T + I, then L L^T must reproduce it
+        if (la_transpose(&At, &Ad) != LA_OK) return 76;
+        if (la_mul(&Spd, &Ad, &At) != LA_OK) return 76;
+        for (size_t i = 0; i < n; i++) LA_AT(&Spd,i,i) += 1.0;
+
+        if (la_par_cholesky(&Lc, &Spd, &po) != LA_OK) return 77;
+        if (la_transpose(&Lt, &Lc) != LA_OK) return 78;
+        if (la_mul(&Got, &Lc, &Lt) != LA_OK) return 78;
+        for (size_t i = 0; i < n * n; i++) {
+            if (fabs(Got.data[i] - Spd.data[i]) > 1e-9) return 79;
+        }
+        la_matrix_free(&Got);
+        la_matrix_free(&Lt);
+
+        // Rank-1 update then downdate of the Cholesky factor
+        Matrix xu = (Matrix){0};
+        if (la_matrix_init(&xu, n, 1) != LA_OK) return 85;
+        for (size_t i = 0; i < n; i++) LA_AT(&xu,i,0) = 0.1 * (double)(i % 5);
+
+        if (la_cholesky_update(&Lc, &xu, 1) != LA_OK) return 86;
+        if (la_transpose(&Lt, &Lc) != LA_OK) return 86;
+        if (la_mul(&Got, &Lc, &Lt) != LA_OK) return 86;
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = 0; j < n; j++) {
+                double want = LA_AT(&Spd,i,j) + LA_AT(&xu,i,0) * LA_AT(&xu,j,0);
+                if (fabs(LA_AT(&Got,i,j) - want) > 1e-9) return 87;
+            }
+        }
+        la_matrix_free(&Got);
+        la_matrix_free(&Lt);
+
+        if (la_cholesky_update(&Lc, &xu, -1) != LA_OK) return 88;
+        if (la_transpose(&Lt, &Lc) != LA_OK) return 88;
+        if (la_mul(&Got, &Lc, &Lt) != LA_OK) return 88;
+        for (size_t i = 0; i < n * n; i++) {
+            if (fabs(Got.data[i] - Spd.data[i]) > 1e-9) return 89;
+        }
+        la_matrix_free(&xu);
+
+        la_matrix_free(&Got);
+        la_matrix_free(&Lt);
+        la_matrix_free(&Lc);
+        la_matrix_free(&Spd);
+        la_matrix_free(&At);
+        la_matrix_free(&Ad);
+    }
+
+    // ---- Service protocol ----
+    // Request header and matrix round-trip; bad shapes and EOF are refused
+    {
+        int sv[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) return 170;
+
+        const la_req_header h = {LA_PROTO_MAGIC, LA_OP_SOLVE, 42, 2, 0};
+        la_req_header hr;
+        if (!la_proto_write_full(sv[0], &h, sizeof(h))) return 171;
+        if (!la_proto_send_matrix(sv[0], &A) || !la_proto_send_matrix(sv[0], &b2)) return 171;
+        if (!la_proto_read_full(sv[1], &hr, sizeof(hr))) return 172;
+        if (hr.magic != h.magic || hr.op != h.op || hr.id != h.id || hr.nmat != h.nmat) {
+            return 172;
+        }
+
+        Matrix ga = (Matrix){0}, gb = (Matrix){0};
+        if (!la_proto_recv_matrix(sv[1], &ga) || !la_proto_recv_matrix(sv[1], &gb)) return 173;
+        if (ga.rows != A.rows || ga.cols != A.cols || gb.rows != 2 || gb.cols != 1) return 173;
+        if (memcmp(ga.data, A.data, 4 * sizeof(double)) != 0) return 173;
+        if (memcmp(gb.data, b2.data, 2 * sizeof(double)) != 0) return 173;
+        la_matrix_free(&ga);
+        la_matrix_free(&gb);
+
+        const uint64_t empty[2] = {0, 3};
+        const uint64_t huge[2] = {LA_PROTO_MAX_ELEMS, 2};
+        if (!la_proto_write_full(sv[0], empty, sizeof(empty))) return 174;
+        if (la_proto_recv_matrix(sv[1], &ga) || ga.data) return 174;
+        if (!la_proto_write_full(sv[0], huge, sizeof(huge))) return 175;
+        if (la_proto_recv_matrix(sv[1], &ga) || ga.data) return 175;
+
+        close(sv[0]);
+        if (la_proto_read_full(sv[1], &hr, sizeof(hr))) return 176;
+        close(sv[1]);
+        if (strcmp(la_proto_op_name(LA_OP_DET), "det") != 0) return 176;
+    }
+
     la_matrix_free(&x);
     la_matrix_free(&A2);
     la_matrix_free(&b2);